@@ -3,8 +3,19 @@
 #
 # Automatically uses Docker for cross-compilation if needed.
 # Set CROSS_PREFIX to skip Docker (e.g., for native ARM builds).
+#
+# --with-tests also cross-compiles the tests into build/tests/ (run
+# them on the Move); packaging never depends on them.
 set -e
 
+WITH_TESTS=0
+for arg in "$@"; do
+    case "$arg" in
+        --with-tests) WITH_TESTS=1 ;;
+        *) echo "usage: $0 [--with-tests]" >&2; exit 2 ;;
+    esac
+done
+
 SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
 REPO_ROOT="$(dirname "$SCRIPT_DIR")"
 IMAGE_NAME="move-anything-builder"
@@ -28,7 +39,7 @@ if [ -z "$CROSS_PREFIX" ] && [ ! -f "/.dockerenv" ]; then
         -u "$(id -u):$(id -g)" \
         -w /build \
         "$IMAGE_NAME" \
-        ./scripts/build.sh
+        ./scripts/build.sh "$@"
 
     echo ""
     echo "=== Done ==="
@@ -47,17 +58,35 @@ echo "Cross prefix: $CROSS_PREFIX"
 mkdir -p build
 mkdir -p dist/junologue-chorus
 
-# Compile DSP plugin (with aggressive optimizations for CM4)
+# Compile DSP plugin (with aggressive optimizations for CM4): the C
+# shim plus the templated tap stages, which need no C++ runtime
+echo "Compiling DSP core..."
+${CROSS_PREFIX}g++ -std=c++17 -fno-exceptions -fno-rtti \
+    -Ofast -fPIC -Wall \
+    -march=armv8-a -mtune=cortex-a72 \
+    -fomit-frame-pointer -fno-stack-protector \
+    -DNDEBUG \
+    -c src/dsp/jc_core.cpp \
+    -o build/jc_core.o \
+    -Isrc/dsp
+
 echo "Compiling DSP plugin..."
-${CROSS_PREFIX}gcc -Ofast -shared -fPIC \
+${CROSS_PREFIX}gcc -Ofast -shared -fPIC -Wall \
     -march=armv8-a -mtune=cortex-a72 \
     -fomit-frame-pointer -fno-stack-protector \
     -DNDEBUG \
-    src/dsp/junologue_chorus.c \
+    src/dsp/junologue_chorus.c build/jc_core.o \
     -o build/junologue-chorus.so \
     -Isrc/dsp \
     -lm
 
+# The tests for the Move, on request: they compile the process kernels
+# and jc_simd.h's NEON branches again, and the binaries in build/tests/
+# can be run on the device
+if [ "$WITH_TESTS" -eq 1 ]; then
+    CROSS_PREFIX="$CROSS_PREFIX" ./scripts/run_tests.sh
+fi
+
 # Copy files to dist (use cat to avoid ExtFS deallocation issues with Docker)
 echo "Packaging..."
 cat src/module.json > dist/junologue-chorus/module.json
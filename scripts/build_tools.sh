@@ -0,0 +1,77 @@
+#!/usr/bin/env bash
+# Build desktop tools for Junologue Chorus
+#
+# Builds the plugin for the build machine plus the headless Move host
+# stand-in (tools/move_host) and the DSP benchmark (tools/bench), so
+# the module can be run, profiled and regression-tested without a Move.
+#
+# Native by default. Set CROSS_PREFIX (e.g. aarch64-linux-gnu-) to
+# build the same tools for the Move's CPU; the build.sh Docker image
+# already sets it.
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+REPO_ROOT="$(dirname "$SCRIPT_DIR")"
+CC="${CROSS_PREFIX}gcc"
+CXX="${CROSS_PREFIX}g++"
+
+ARCH_FLAGS=""
+if [ -n "$CROSS_PREFIX" ]; then
+    ARCH_FLAGS="-march=armv8-a -mtune=cortex-a72"
+fi
+
+cd "$REPO_ROOT"
+
+echo "=== Building Junologue Chorus tools ==="
+echo "Compilers: $CC, $CXX"
+
+mkdir -p build/tools
+
+echo "Compiling DSP core..."
+$CXX -std=c++17 -fno-exceptions -fno-rtti \
+    -Ofast -fPIC -Wall $ARCH_FLAGS \
+    -DNDEBUG \
+    -c src/dsp/jc_core.cpp \
+    -o build/tools/jc_core.o \
+    -Isrc/dsp
+
+echo "Compiling DSP plugin..."
+$CC -Ofast -shared -fPIC $ARCH_FLAGS \
+    -DNDEBUG \
+    src/dsp/junologue_chorus.c build/tools/jc_core.o \
+    -o build/tools/junologue-chorus.so \
+    -Isrc/dsp \
+    -lm
+
+echo "Compiling move-host..."
+$CC -O2 -Wall $ARCH_FLAGS \
+    tools/move_host/move_host.c \
+    tools/move_host/move_host_cli.c \
+    -o build/tools/move-host \
+    -Isrc/dsp -Itools/move_host \
+    -ldl -lm
+
+echo "Compiling jc-render..."
+$CC -O2 -Wall $ARCH_FLAGS \
+    tools/move_host/move_host.c \
+    tools/render/jc_render.c \
+    -o build/tools/jc-render \
+    -Isrc/dsp -Itools/move_host \
+    -ldl -lm
+
+echo "Compiling jc-bench..."
+$CC -Ofast -Wall $ARCH_FLAGS \
+    -DNDEBUG \
+    tools/bench/jc_bench.c build/tools/jc_core.o \
+    -o build/tools/jc-bench \
+    -Isrc/dsp \
+    -lm
+
+echo ""
+echo "=== Build Complete ==="
+echo "Output: build/tools/"
+echo ""
+echo "Example:"
+echo "  build/tools/move-host -p mode=I -p mix=0.7 -g state build/tools/junologue-chorus.so"
+echo "  build/tools/jc-render -p mode=I+II -a mix=0:0,4:1 -i in.wav -o out.wav build/tools/junologue-chorus.so"
+echo "  build/tools/jc-bench > bench.json"
@@ -0,0 +1,87 @@
+#!/usr/bin/env bash
+# Build and run the Junologue Chorus tests
+#
+# Every tests/test_*.c is a standalone program that includes the plugin
+# source and links the DSP core (src/dsp/jc_core.cpp). They are built
+# with the plugin's release flags (-Ofast), so they check the code that
+# ships; test_params_threads is built with ThreadSanitizer instead and
+# fails on any reported race.
+#
+# Native by default; CROSS_PREFIX builds them for the Move's CPU (run
+# the binaries in build/tests/ there). A cross toolchain may have no
+# TSan runtime; test_params_threads is then skipped with a warning.
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+REPO_ROOT="$(dirname "$SCRIPT_DIR")"
+CC="${CROSS_PREFIX}gcc"
+CXX="${CROSS_PREFIX}g++"
+
+ARCH_FLAGS=""
+if [ -n "$CROSS_PREFIX" ]; then
+    ARCH_FLAGS="-march=armv8-a -mtune=cortex-a72"
+fi
+
+cd "$REPO_ROOT"
+
+echo "=== Building Junologue Chorus tests ==="
+echo "Compilers: $CC, $CXX"
+
+mkdir -p build/tests
+
+echo "Checking jc_dsp.h on its own (-std=c99)..."
+echo '#include "jc_dsp.h"' | $CC -std=c99 -Wall -Werror -fsyntax-only $ARCH_FLAGS -x c - -Isrc/dsp
+echo "Checking jc_core.hpp on its own (-std=c++17)..."
+echo '#include "jc_core.hpp"' | $CXX -std=c++17 -Wall -Wextra -Werror -fsyntax-only $ARCH_FLAGS \
+    -x c++ - -Isrc/dsp
+
+echo "Compiling DSP core..."
+CORE=build/tests/jc_core.o
+$CXX -std=c++17 -fno-exceptions -fno-rtti -Ofast -DNDEBUG -Wall $ARCH_FLAGS \
+    -c src/dsp/jc_core.cpp -o $CORE -Isrc/dsp
+
+for src in tests/test_*.c; do
+    name="$(basename "$src" .c)"
+    case "$name" in
+        test_params_threads) FLAGS="-O1 -g -fsanitize=thread" ;;
+        *)                   FLAGS="-Ofast -DNDEBUG" ;;
+    esac
+    echo "Compiling $name..."
+    if [ -n "$CROSS_PREFIX" ] && [ "$name" = test_params_threads ]; then
+        $CC $FLAGS -Wall $ARCH_FLAGS "$src" $CORE -o "build/tests/$name" -Isrc/dsp -lm -lpthread ||
+            echo "warning: $name skipped (no ThreadSanitizer runtime for $CC)" >&2
+        continue
+    fi
+    $CC $FLAGS -Wall $ARCH_FLAGS "$src" $CORE -o "build/tests/$name" -Isrc/dsp -lm -lpthread
+done
+
+# jc_simd.h's other branches on a host without NEON: the generic vector
+# code, and the NEON code over the lane-by-lane tests/neon/arm_neon.h
+VARIANTS=""
+if [ -z "$CROSS_PREFIX" ] && ! $CC -dM -E - </dev/null | grep -q __ARM_NEON; then
+    echo "Compiling test_simd_generic..."
+    $CC -Ofast -DNDEBUG -Wall -U__SSE2__ tests/test_simd.c $CORE -o build/tests/test_simd_generic \
+        -Isrc/dsp -lm -lpthread
+    echo "Compiling test_simd_neon..."
+    $CC -Ofast -DNDEBUG -Wall -D__ARM_NEON=1 -Itests/neon tests/test_simd.c $CORE \
+        -o build/tests/test_simd_neon -Isrc/dsp -lm -lpthread
+    VARIANTS="test_simd_generic test_simd_neon"
+fi
+
+[ -n "$CROSS_PREFIX" ] && exit 0
+
+echo ""
+echo "=== Running tests ==="
+failed=0
+for name in $(for src in tests/test_*.c; do basename "$src" .c; done) $VARIANTS; do
+    if ! TSAN_OPTIONS="halt_on_error=1" "build/tests/$name"; then
+        failed=$((failed + 1))
+    fi
+done
+
+echo ""
+if [ "$failed" -ne 0 ]; then
+    echo "=== $failed test program(s) failed ==="
+    exit 1
+fi
+echo "=== All tests passed ==="
@@ -0,0 +1,79 @@
+/*
+ * jc_core.cpp - the templated tap stages, instantiated for the plugin
+ *
+ * One table per process kernel (see JC_KERNEL in junologue_chorus.c),
+ * each built with the same target attribute as the kernel's half in
+ * the plugin. A table has a row per specialized ring rate, the Move's
+ * rate and its half-rate wet path, plus the run-time-rate row for any
+ * other host rate. Only the tables (C linkage, hidden outside the
+ * module) are visible to the plugin.
+ */
+
+#include "plugin_api_v1.h"
+
+#define JC_CHUNK MOVE_FRAMES_PER_BLOCK
+
+#include "jc_core.hpp"
+
+namespace {
+
+using jc::Interp;
+using jc::Stage;
+
+/* Ring rates with their own row, besides the run-time one */
+constexpr int RATE_FULL = MOVE_SAMPLE_RATE;
+constexpr int RATE_HALF = MOVE_SAMPLE_RATE / 2;
+static_assert(RATE_HALF * 2 == RATE_FULL, "half-rate ring rate must be exact");
+
+#define JC_CORE_STAGES(r, k, interp)                                        \
+    { k::taps<r, interp, Stage::i>, k::taps<r, interp, Stage::i_ii>,        \
+      k::taps<r, interp, Stage::ii>, k::taps<r, interp, Stage::ramp> }
+
+#define JC_CORE_ROW(r, k)                                                   \
+    { (float)r,                                                             \
+      { JC_CORE_STAGES(r, k, Interp::linear),                               \
+        JC_CORE_STAGES(r, k, Interp::hermite),                              \
+        JC_CORE_STAGES(r, k, Interp::thiran) },                             \
+      { k::taps_q15<r, Stage::i>, k::taps_q15<r, Stage::i_ii>,              \
+        k::taps_q15<r, Stage::ii>, k::taps_q15<r, Stage::ramp> } }
+
+/*
+ * JC_CORE_KERNEL instantiates the stages under the kernel's attribute;
+ * flatten inlines the template and the jc_dsp.h primitives into them
+ */
+#define JC_CORE_KERNEL(k, attr)                                             \
+namespace k {                                                               \
+template <int Rate, Interp I, Stage S>                                      \
+attr void taps(const jc_core_taps_t *t, const float *ring, int n) {         \
+    jc::Taps<float, Rate, I, S>::run(*t, ring, n);                          \
+}                                                                           \
+template <int Rate, Stage S>                                                \
+attr void taps_q15(const jc_core_taps_t *t, const int16_t *ring, int n) {   \
+    jc::Taps<int16_t, Rate, Interp::linear, S>::run(*t, ring, n);           \
+}                                                                           \
+const jc_core_row_t ROWS[] = {                                              \
+    JC_CORE_ROW(RATE_FULL, k), JC_CORE_ROW(RATE_HALF, k), JC_CORE_ROW(0, k) \
+};                                                                          \
+}
+
+#if defined(__x86_64__)
+JC_CORE_KERNEL(avx2,  JC_KERNEL_ATTR_AVX2)
+JC_CORE_KERNEL(sse41, JC_KERNEL_ATTR_SSE41)
+#elif defined(__aarch64__)
+JC_CORE_KERNEL(v82, JC_KERNEL_ATTR_V82)
+#endif
+JC_CORE_KERNEL(base,   JC_KERNEL_ATTR_BASE)
+JC_CORE_KERNEL(scalar, JC_KERNEL_ATTR_SCALAR)
+
+} /* namespace */
+
+#define JC_CORE_TABLE(k) { k::ROWS, (int)(sizeof(k::ROWS) / sizeof(k::ROWS[0])) }
+
+#if defined(__x86_64__)
+const jc_core_kernel_t jc_core_avx2  = JC_CORE_TABLE(avx2);
+const jc_core_kernel_t jc_core_sse41 = JC_CORE_TABLE(sse41);
+#elif defined(__aarch64__)
+const jc_core_kernel_t jc_core_v82 = JC_CORE_TABLE(v82);
+#endif
+const jc_core_kernel_t jc_core_base   = JC_CORE_TABLE(base);
+const jc_core_kernel_t jc_core_scalar = JC_CORE_TABLE(scalar);
@@ -0,0 +1,100 @@
+/*
+ * jc_core.h - C interface to the templated tap stages
+ *
+ * The ideal model's tap stages (LFOs -> fractional delay reads -> mode
+ * gains) are C++ templates in jc_core.hpp, specialized on ring sample
+ * type, ring rate, interpolation tier and mode. jc_core.cpp compiles
+ * them once per process kernel and exports the tables declared here
+ * as plain C; the plugin binds each instance to a kernel's row for its
+ * ring rate at create_instance and calls the stages by pointer.
+ *
+ * Include after defining JC_CHUNK, as for jc_dsp.h; the core and its
+ * callers must agree on it.
+ */
+
+#ifndef JC_CORE_H
+#define JC_CORE_H
+
+#include "jc_dsp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Fractional delay interpolation for the ideal engine, cheapest first */
+#define JC_INTERP_LINEAR  0
+#define JC_INTERP_HERMITE 1
+#define JC_INTERP_THIRAN  2
+
+/* Tap stages are indexed by mode (matching MODE_GAIN), then the ramp stage */
+#define JC_TAP_RAMP 3
+
+/*
+ * Process kernel attributes, shared by the plugin's kernels and the
+ * core's so both halves of a kernel target the same instructions
+ */
+#define JC_KERNEL_ATTR_AVX2   __attribute__((flatten, target("avx2,fma")))
+#define JC_KERNEL_ATTR_SSE41  __attribute__((flatten, target("sse4.1")))
+#define JC_KERNEL_ATTR_V82    __attribute__((flatten, target("arch=armv8.2-a+fp16+dotprod")))
+#define JC_KERNEL_ATTR_BASE   __attribute__((flatten))
+#define JC_KERNEL_ATTR_SCALAR __attribute__((flatten, optimize("no-tree-vectorize")))
+
+/*
+ * The instance state a tap stage works on. LFOs in use are filled,
+ * the others only advanced; the ramp stages read their gains from
+ * gain_a/gain_b, the others use their mode's constant gains. Float
+ * stages write wet_l/wet_r (and keep the Thiran state in ap_y), Q15
+ * stages q_wet_l/q_wet_r in Q30. The delays are read only by the
+ * run-time-rate row; the others have their rate's built in.
+ */
+typedef struct {
+    lfo_t     *lfo1, *lfo2;
+    jc_ramp_t *gain_a, *gain_b;
+    float     *ap_y;            /* [4]: LFO1 L/R, LFO2 L/R */
+    float     *wet_l, *wet_r;
+    int32_t   *q_wet_l, *q_wet_r;
+    float      dt_min, dt_rng;      /* ring samples */
+    int32_t    q_dt_min, q_dt_rng;  /* the same in 16.16 */
+} jc_core_taps_t;
+
+/* (state, ring at frame 0 of the chunk, frames); n is at most JC_CHUNK */
+typedef void (*jc_core_tap_fn)(const jc_core_taps_t *t, const float *ring, int n);
+typedef void (*jc_core_tap_q15_fn)(const jc_core_taps_t *t, const int16_t *ring, int n);
+
+/* One kernel's tap stages at one ring rate */
+typedef struct {
+    float rate;                         /* ring rate; 0 for the run-time-rate row */
+    jc_core_tap_fn     taps[3][4];      /* [JC_INTERP_*][mode or JC_TAP_RAMP] */
+    jc_core_tap_q15_fn taps_q15[4];     /* Q15 ring, linear taps only */
+} jc_core_row_t;
+
+/* A kernel's rows: the specialized rates, then the run-time-rate row */
+typedef struct {
+    const jc_core_row_t *rows;
+    int num_rows;
+} jc_core_kernel_t;
+
+/* Internal to the module: the .so exports only the FX API entry points */
+#pragma GCC visibility push(hidden)
+#if defined(__x86_64__)
+extern const jc_core_kernel_t jc_core_avx2;
+extern const jc_core_kernel_t jc_core_sse41;
+#elif defined(__aarch64__)
+extern const jc_core_kernel_t jc_core_v82;
+#endif
+extern const jc_core_kernel_t jc_core_base;
+extern const jc_core_kernel_t jc_core_scalar;
+#pragma GCC visibility pop
+
+/* The row specialized for ring_rate, or the run-time-rate one */
+static inline const jc_core_row_t *jc_core_bind(const jc_core_kernel_t *k, float ring_rate) {
+    int i = 0;
+    while (i < k->num_rows - 1 && k->rows[i].rate != ring_rate) i++;
+    return &k->rows[i];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* JC_CORE_H */
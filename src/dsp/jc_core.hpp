@@ -0,0 +1,301 @@
+/*
+ * jc_core.hpp - Junologue Chorus tap stages, templated
+ *
+ * Header-only C++17 over the jc_dsp.h primitives. A tap stage runs the
+ * LFOs, reads the delay ring at the modulated tap delays and sums the
+ * taps with the mode gains, for one chunk. Taps<Sample, Rate, Interp,
+ * Stage> is one fully specialized stage:
+ *
+ *   Sample  ring sample type: float, or int16_t for the Q15 ring of
+ *           the fixed-point engine (linear taps only)
+ *   Rate    ring rate in Hz; the tap delays are constexpr for it. 0
+ *           reads them from jc_core_taps_t instead, for any other rate.
+ *   Interp  fractional delay interpolator (linear, Hermite, Thiran)
+ *   Stage   mode I, I+II or II, with its gains and the LFOs it uses
+ *           taken from MODE_GAIN at compile time, or the ramp stage,
+ *           which runs both taps on per-frame gains
+ *
+ * Every choice is made with if constexpr, so an instantiation has no
+ * branches on its configuration: a silent LFO costs no taps (its phase
+ * is advanced analytically, keeping mode switches phase-coherent) and
+ * each tier gets its own loop.
+ *
+ * jc_core.cpp instantiates these per process kernel behind the C
+ * tables of jc_core.h. JC_CHUNK must be defined as for jc_dsp.h.
+ */
+
+#ifndef JC_CORE_HPP
+#define JC_CORE_HPP
+
+#include "jc_core.h"
+
+namespace jc {
+
+enum class Interp { linear = JC_INTERP_LINEAR, hermite = JC_INTERP_HERMITE,
+                    thiran = JC_INTERP_THIRAN };
+
+enum class Stage { i = 0, i_ii = 1, ii = 2, ramp = JC_TAP_RAMP };
+
+/* --- Constant tables --- */
+
+/* lrintf() for the non-negative values below */
+constexpr int32_t round_even(float x) {
+    int32_t i = (int32_t)x;
+    float f = x - (float)i;
+    return i + (f > 0.5f || (f == 0.5f && (i & 1)));
+}
+
+/* jc_q31() */
+constexpr int32_t q31(float x) {
+    return x >= 1.0f ? INT32_MAX : (int32_t)(x * 2147483648.0f);
+}
+
+/*
+ * Tap delays at ring rate Rate, as the plugin computes them for the
+ * instance (jc_set_ring_rate): shortest tap and sweep range in ring
+ * samples, and the same in 16.16 for the Q15 ring
+ */
+template <int Rate>
+struct Delays {
+    static constexpr float dt_min = DELAY_MIN_SEC * (float)Rate;
+    static constexpr float dt_rng = (DELAY_MAX_SEC - DELAY_MIN_SEC) * (float)Rate;
+    static constexpr int32_t q_dt_min = round_even(dt_min * 65536.0f);
+    static constexpr int32_t q_dt_rng = round_even(dt_rng * 65536.0f);
+
+    static float min(const jc_core_taps_t &) { return dt_min; }
+    static float rng(const jc_core_taps_t &) { return dt_rng; }
+    static int32_t q_min(const jc_core_taps_t &) { return q_dt_min; }
+    static int32_t q_rng(const jc_core_taps_t &) { return q_dt_rng; }
+};
+
+template <>
+struct Delays<0> {
+    static float min(const jc_core_taps_t &t) { return t.dt_min; }
+    static float rng(const jc_core_taps_t &t) { return t.dt_rng; }
+    static int32_t q_min(const jc_core_taps_t &t) { return t.q_dt_min; }
+    static int32_t q_rng(const jc_core_taps_t &t) { return t.q_dt_rng; }
+};
+
+/* A stage's taps: the mode's gains from MODE_GAIN, and which LFOs they need */
+template <Stage S>
+struct Gains {
+    static constexpr bool ramp = S == Stage::ramp;
+    static constexpr float a = ramp ? 0.0f : MODE_GAIN[(int)S][0];
+    static constexpr float b = ramp ? 0.0f : MODE_GAIN[(int)S][1];
+    static constexpr int32_t q_a = q31(a);
+    static constexpr int32_t q_b = q31(b);
+    static constexpr bool use_a = ramp || a != 0.0f;
+    static constexpr bool use_b = ramp || b != 0.0f;
+};
+
+/* --- Fractional reads --- */
+
+template <Interp I>
+__attribute__((always_inline)) inline float read(const float *p, float delay_samples, float *ap) {
+    if constexpr (I == Interp::thiran)  return delay_read_thiran(p, delay_samples, ap);
+    if constexpr (I == Interp::hermite) return delay_read_hermite(p, delay_samples);
+    if constexpr (I == Interp::linear)  return delay_read_frac(p, delay_samples);
+}
+
+/* read() for frames p[0..3] of the stateless tiers */
+template <Interp I>
+__attribute__((always_inline)) inline jc_v4f read_v4(const float *p, jc_v4f delay_samples) {
+    static_assert(I != Interp::thiran, "Thiran taps recur frame to frame");
+    if constexpr (I == Interp::hermite) return delay_read_hermite_v4(p, delay_samples);
+    if constexpr (I == Interp::linear)  return delay_read_frac_v4(p, delay_samples);
+}
+
+/* --- Tap stages --- */
+
+template <typename Sample, int Rate, Interp I, Stage S>
+struct Taps;
+
+/*
+ * Float ring. Left taps follow the LFO, right ones its inverse
+ * (180-degree phase opposition), matching the Juno-60's dual-BBD
+ * stereo architecture.
+ */
+template <int Rate, Interp I, Stage S>
+struct Taps<float, Rate, I, S> {
+    using G = Gains<S>;
+
+    __attribute__((always_inline))
+    static inline void run(const jc_core_taps_t &t, const float *p, int n) {
+        const float dt_min = Delays<Rate>::min(t);
+        const float dt_rng = Delays<Rate>::rng(t);
+        float v1[JC_CHUNK] JC_ALIGNED;
+        float v2[JC_CHUNK] JC_ALIGNED;
+        float ga[JC_CHUNK] JC_ALIGNED;
+        float gb[JC_CHUNK] JC_ALIGNED;
+        float ap[4] = { t.ap_y[0], t.ap_y[1], t.ap_y[2], t.ap_y[3] };
+
+        if constexpr (G::ramp) {
+            jc_ramp_fill(t.gain_a, ga, n);
+            jc_ramp_fill(t.gain_b, gb, n);
+        }
+        if constexpr (G::use_a) lfo_fill(t.lfo1, v1, n);
+        else                    lfo_advance(t.lfo1, n);
+        if constexpr (G::use_b) lfo_fill(t.lfo2, v2, n);
+        else                    lfo_advance(t.lfo2, n);
+
+        /* Linear and Hermite taps four frames at a time, gathering the samples */
+        int i = 0;
+        if constexpr (I != Interp::thiran) {
+            for (; i + 4 <= n; i += 4) {
+                jc_v4f wet_l = jc_v4f_set1(0.0f);
+                jc_v4f wet_r = jc_v4f_set1(0.0f);
+
+                if constexpr (G::use_a) {
+                    jc_v4f v = jc_v4f_load(v1 + i);
+                    jc_v4f g = G::ramp ? jc_v4f_load(ga + i) : jc_v4f_set1(G::a);
+                    wet_l += g * read_v4<I>(p + i, dt_min + dt_rng * v);
+                    wet_r += g * read_v4<I>(p + i, dt_min + dt_rng * (1.0f - v));
+                }
+                if constexpr (G::use_b) {
+                    jc_v4f v = jc_v4f_load(v2 + i);
+                    jc_v4f g = G::ramp ? jc_v4f_load(gb + i) : jc_v4f_set1(G::b);
+                    wet_l += g * read_v4<I>(p + i, dt_min + dt_rng * v);
+                    wet_r += g * read_v4<I>(p + i, dt_min + dt_rng * (1.0f - v));
+                }
+
+                jc_v4f_store(t.wet_l + i, wet_l);
+                jc_v4f_store(t.wet_r + i, wet_r);
+            }
+        }
+
+        /*
+         * Thiran taps with both LFOs: the allpass states recur frame to
+         * frame, so the lanes are the four taps {A left, A right, B left,
+         * B right}. Four frames of delays are transposed into per-frame
+         * tap vectors and the outputs back into per-tap frame vectors.
+         * With one LFO silent, half the lanes would idle, and the scalar
+         * loop is faster.
+         */
+        if constexpr (I == Interp::thiran && G::use_a && G::use_b) {
+            jc_v4f y1 = jc_v4f_load(ap);
+            for (; i + 4 <= n; i += 4) {
+                jc_v4f a = jc_v4f_load(v1 + i);
+                jc_v4f b = jc_v4f_load(v2 + i);
+                jc_v4f y[4] = {
+                    dt_min + dt_rng * a, dt_min + dt_rng * (1.0f - a),
+                    dt_min + dt_rng * b, dt_min + dt_rng * (1.0f - b)
+                };
+
+                jc_v4f_transpose4(y);
+                for (int k = 0; k < 4; k++)
+                    y[k] = delay_read_thiran_v4(p + i + k, y[k], &y1);
+                jc_v4f_transpose4(y);
+
+                jc_v4f ga_i = G::ramp ? jc_v4f_load(ga + i) : jc_v4f_set1(G::a);
+                jc_v4f gb_i = G::ramp ? jc_v4f_load(gb + i) : jc_v4f_set1(G::b);
+                jc_v4f_store(t.wet_l + i, ga_i * y[0] + gb_i * y[2]);
+                jc_v4f_store(t.wet_r + i, ga_i * y[1] + gb_i * y[3]);
+            }
+            jc_v4f_store(ap, y1);
+        }
+
+        for (; i < n; i++) {
+            float wet_l = 0.0f;
+            float wet_r = 0.0f;
+
+            if constexpr (G::use_a) {
+                float g = G::ramp ? ga[i] : G::a;
+                wet_l += g * read<I>(p + i, dt_min + dt_rng * v1[i], &ap[0]);
+                wet_r += g * read<I>(p + i, dt_min + dt_rng * (1.0f - v1[i]), &ap[1]);
+            }
+            if constexpr (G::use_b) {
+                float g = G::ramp ? gb[i] : G::b;
+                wet_l += g * read<I>(p + i, dt_min + dt_rng * v2[i], &ap[2]);
+                wet_r += g * read<I>(p + i, dt_min + dt_rng * (1.0f - v2[i]), &ap[3]);
+            }
+
+            t.wet_l[i] = wet_l;
+            t.wet_r[i] = wet_r;
+        }
+
+        if constexpr (I == Interp::thiran)
+            memcpy(t.ap_y, ap, sizeof(ap));
+    }
+};
+
+/*
+ * Q15 ring, Q30 taps: linear reads four frames per vector. The Q31 LFO
+ * scales the 16.16 delay range with vqdmulh; the right tap uses
+ * INT32_MAX - v, i.e. 1 - v.
+ */
+template <int Rate, Stage S>
+struct Taps<int16_t, Rate, Interp::linear, S> {
+    using G = Gains<S>;
+
+    __attribute__((always_inline))
+    static inline void run(const jc_core_taps_t &t, const int16_t *p, int n) {
+        const int32_t dt_min = Delays<Rate>::q_min(t);
+        const int32_t dt_rng = Delays<Rate>::q_rng(t);
+        int32_t v1[JC_CHUNK] JC_ALIGNED;
+        int32_t v2[JC_CHUNK] JC_ALIGNED;
+        int32_t ga[JC_CHUNK] JC_ALIGNED;
+        int32_t gb[JC_CHUNK] JC_ALIGNED;
+
+        if constexpr (G::ramp) {
+            jc_ramp_fill_q31(t.gain_a, ga, n);
+            jc_ramp_fill_q31(t.gain_b, gb, n);
+        }
+        if constexpr (G::use_a) lfo_fill_q31(t.lfo1, v1, n);
+        else                    lfo_advance(t.lfo1, n);
+        if constexpr (G::use_b) lfo_fill_q31(t.lfo2, v2, n);
+        else                    lfo_advance(t.lfo2, n);
+
+        int i = 0;
+        for (; i + 4 <= n; i += 4) {
+            jc_v4i wet_l = jc_v4i_set1(0);
+            jc_v4i wet_r = jc_v4i_set1(0);
+
+            if constexpr (G::use_a) {
+                jc_v4i v = jc_v4i_load(v1 + i);
+                jc_v4i g = G::ramp ? jc_v4i_load(ga + i) : jc_v4i_set1(G::q_a);
+                jc_v4i d_l = dt_min + jc_v4i_qdmulh_n(v, dt_rng);
+                jc_v4i d_r = dt_min + jc_v4i_qdmulh_n(INT32_MAX - v, dt_rng);
+                wet_l += jc_v4i_qdmulh(delay_read_q30_v4(p + i, d_l), g);
+                wet_r += jc_v4i_qdmulh(delay_read_q30_v4(p + i, d_r), g);
+            }
+            if constexpr (G::use_b) {
+                jc_v4i v = jc_v4i_load(v2 + i);
+                jc_v4i g = G::ramp ? jc_v4i_load(gb + i) : jc_v4i_set1(G::q_b);
+                jc_v4i d_l = dt_min + jc_v4i_qdmulh_n(v, dt_rng);
+                jc_v4i d_r = dt_min + jc_v4i_qdmulh_n(INT32_MAX - v, dt_rng);
+                wet_l += jc_v4i_qdmulh(delay_read_q30_v4(p + i, d_l), g);
+                wet_r += jc_v4i_qdmulh(delay_read_q30_v4(p + i, d_r), g);
+            }
+
+            jc_v4i_store(t.q_wet_l + i, wet_l);
+            jc_v4i_store(t.q_wet_r + i, wet_r);
+        }
+
+        for (; i < n; i++) {
+            int32_t wet_l = 0;
+            int32_t wet_r = 0;
+
+            if constexpr (G::use_a) {
+                int32_t g = G::ramp ? ga[i] : G::q_a;
+                int32_t d_l = dt_min + jc_qdmulh_s32(v1[i], dt_rng);
+                int32_t d_r = dt_min + jc_qdmulh_s32(INT32_MAX - v1[i], dt_rng);
+                wet_l += jc_qdmulh_s32(delay_read_q30(p + i, d_l), g);
+                wet_r += jc_qdmulh_s32(delay_read_q30(p + i, d_r), g);
+            }
+            if constexpr (G::use_b) {
+                int32_t g = G::ramp ? gb[i] : G::q_b;
+                int32_t d_l = dt_min + jc_qdmulh_s32(v2[i], dt_rng);
+                int32_t d_r = dt_min + jc_qdmulh_s32(INT32_MAX - v2[i], dt_rng);
+                wet_l += jc_qdmulh_s32(delay_read_q30(p + i, d_l), g);
+                wet_r += jc_qdmulh_s32(delay_read_q30(p + i, d_r), g);
+            }
+
+            t.q_wet_l[i] = wet_l;
+            t.q_wet_r[i] = wet_r;
+        }
+    }
+};
+
+} /* namespace jc */
+
+#endif /* JC_CORE_HPP */
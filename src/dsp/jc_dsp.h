@@ -0,0 +1,1244 @@
+/*
+ * jc_dsp.h - Junologue Chorus DSP core
+ *
+ * Header-only building blocks of the chorus: the Juno-60 delay and LFO
+ * constants, filters, mirrored delay ring and interpolators, exact
+ * LFO, halfband resampler, BBD model, Q15/Q31 primitives, parameter
+ * ramps and the interleaved conversion kernels, extracted as plain C
+ * from the plugin. Everything is static inline, so each includer gets
+ * its own copy, inlined at its call sites; there is no library to
+ * link.
+ *
+ * It is shared by C and C++: the plugin includes it as C99, and the
+ * templated tap stages (jc_core.hpp) specialize on its constants and
+ * call its primitives from C++, where the constant tables are
+ * constexpr.
+ *
+ * The plugin (junologue_chorus.c) is the host-facing shim: instances,
+ * parameters, the block pipeline and the Move FX API. Tools can
+ * include this header directly.
+ *
+ * JC_CHUNK (frames per pipeline pass, default 128) may be defined
+ * before inclusion; nothing else needs to be. Sample rates are runtime
+ * arguments throughout. Builds under strict -std=c99 and -std=c++17.
+ */
+
+#ifndef JC_DSP_H
+#define JC_DSP_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "jc_simd.h"
+
+/* Strict ISO modes leave M_PI out of math.h */
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+/* Frames per pass of the block pipeline */
+#ifndef JC_CHUNK
+#define JC_CHUNK 128
+#endif
+
+/* Cache line size; DSP buffers are aligned so vector loads never split */
+#define JC_CACHE_LINE 64
+#define JC_ALIGNED __attribute__((aligned(JC_CACHE_LINE)))
+
+/* Constant tables; constexpr under C++, so jc_core.hpp can specialize on them */
+#ifdef __cplusplus
+#define JC_TABLE static constexpr
+#else
+#define JC_TABLE static const
+#endif
+
+/*
+ * Juno-60 chorus delay times from Andy Harman's measurements:
+ * Min delay: 1.66ms, Max delay: 5.35ms (same for both channels)
+ * Stereo from inverted LFO modulation between left and right BBDs.
+ */
+#define DELAY_MIN_SEC  0.00166f
+#define DELAY_MAX_SEC  0.00535f
+
+/*
+ * LFO rates in millihertz (0.513 and 0.863 Hz, from Harman's
+ * measurements); integers so the LFO period is an exact fraction of
+ * the sample rate
+ */
+JC_TABLE uint32_t LFO_RATE_MHZ[2] = { 513, 863 };
+
+/* Mode gains: [lfo1_gain, lfo2_gain] */
+JC_TABLE float MODE_GAIN[3][2] = {
+    { 1.0f, 0.0f },                        /* Mode I   */
+    { 0.70710678f, 0.70710678f },           /* Mode I+II */
+    { 0.0f, 1.0f }                          /* Mode II  */
+};
+
+/* ================================================================
+ * DSP Primitives
+ * ================================================================ */
+
+/* Soft limiter (Emilie Gillet / stmlib) */
+static inline float soft_limit(float x) {
+    return x * (27.0f + x * x) / (27.0f + 9.0f * x * x);
+}
+
+/* soft_limit per lane */
+static inline jc_v4f soft_limit_v4(jc_v4f x) {
+    return x * (27.0f + x * x) / (27.0f + 9.0f * x * x);
+}
+
+/* Fast square root via inverse sqrt approximation */
+static inline float fast_sqrt(float x) {
+    if (x <= 0.0f) return 0.0f;
+    float x2 = x * 0.5f;
+    float y = x;
+    int32_t i;
+    memcpy(&i, &y, sizeof(i));
+    i = 0x5f3759df - (i >> 1);
+    memcpy(&y, &i, sizeof(y));
+    y = y * (1.5f - (x2 * y * y));
+    y = y * (1.5f - (x2 * y * y));
+    return 1.0f / y;
+}
+
+/*
+ * NaN/Inf test on the bits. -Ofast implies -ffinite-math-only, which
+ * lets the compiler fold isfinite() and x != x to constants.
+ */
+static inline int jc_nonfinite(float x) {
+    uint32_t u;
+    memcpy(&u, &x, sizeof(u));
+    return (u & 0x7f800000u) == 0x7f800000u;
+}
+
+/*
+ * Flush denormals to zero while processing (FPCR.FZ on aarch64,
+ * MXCSR FTZ|DAZ on x86), so decaying filter state never hits the slow
+ * path. Returns the previous control word for jc_ftz_leave; the
+ * register is only written when the mode actually changes.
+ */
+static inline uint64_t jc_ftz_enter(void) {
+#if defined(__aarch64__)
+    uint64_t fpcr;
+    __asm__ volatile("mrs %0, fpcr" : "=r"(fpcr));
+    if (!(fpcr & (1u << 24)))
+        __asm__ volatile("msr fpcr, %0" : : "r"(fpcr | (1u << 24)));
+    return fpcr;
+#elif defined(__SSE__)
+    unsigned int csr = _mm_getcsr();
+    if ((csr & 0x8040u) != 0x8040u)
+        _mm_setcsr(csr | 0x8040u);
+    return csr;
+#else
+    return 0;
+#endif
+}
+
+static inline void jc_ftz_leave(uint64_t saved) {
+#if defined(__aarch64__)
+    if (!(saved & (1u << 24)))
+        __asm__ volatile("msr fpcr, %0" : : "r"(saved));
+#elif defined(__SSE__)
+    if (((unsigned int)saved & 0x8040u) != 0x8040u)
+        _mm_setcsr((unsigned int)saved);
+#else
+    (void)saved;
+#endif
+}
+
+/*
+ * One-pole lowpass filter with unity DC gain.
+ *
+ * y[n] = y[n-1] + alpha * (x[n] - y[n-1])
+ *
+ * alpha = w / (1 + w)  where w = 2*pi*fc/fs
+ * This avoids the tan() instability near Nyquist that the bilinear
+ * transform version has, and maintains unity gain at DC.
+ */
+typedef struct {
+    float alpha;
+    float state;
+} fo_lpf_t;
+
+static inline void fo_lpf_init(fo_lpf_t *f) {
+    f->alpha = 1.0f;   /* pass-through until set */
+    f->state = 0.0f;
+}
+
+/* Coefficient for a cutoff in Hz; assigned to fo_lpf_t.alpha */
+static inline float fo_lpf_alpha(float hz, float sample_rate) {
+    if (hz <= 0.0f)
+        return 0.0f;
+    /* Clamp to below Nyquist */
+    if (hz >= sample_rate * 0.49f)
+        return 1.0f;
+    float w = 2.0f * (float)M_PI * hz / sample_rate;
+    return w / (1.0f + w);
+}
+
+static inline float fo_lpf_process(fo_lpf_t *f, float x) {
+    f->state += f->alpha * (x - f->state);
+    return f->state;
+}
+
+/*
+ * Block-parallel form. With b = 1 - alpha, k frames into a block that
+ * starts from state s:
+ *
+ *   y[k] = b^(k+1) s + sum_{j<=k} alpha b^(k-j) x[j]
+ *
+ * Everything but the b^(k+1) s term is independent of s, so the serial
+ * dependency is one multiply-add per block instead of per frame. The
+ * block is closed form, so rounding does not compound beyond what the
+ * per-frame recurrence already has.
+ */
+typedef struct {
+    float p[4];         /* b^(k+1) */
+    float q[4];         /* alpha b^k */
+} fo_lpf_pow_t;
+
+static inline void fo_lpf_pow_init(fo_lpf_pow_t *w, float alpha) {
+    float b = 1.0f - alpha;
+    w->p[0] = b;
+    w->p[1] = b * b;
+    w->p[2] = w->p[1] * b;
+    w->p[3] = w->p[2] * b;
+    w->q[0] = alpha;
+    w->q[1] = alpha * w->p[0];
+    w->q[2] = alpha * w->p[1];
+    w->q[3] = alpha * w->p[2];
+}
+
+/* fo_lpf_process over x[0..n) in place, four frames per vector */
+static inline void fo_lpf_block(fo_lpf_t *f, float *x, int n) {
+    fo_lpf_pow_t w;
+    fo_lpf_pow_init(&w, f->alpha);
+    const jc_v4f p  = { w.p[0], w.p[1], w.p[2], w.p[3] };
+    const jc_v4f q0 = { w.q[0], w.q[1], w.q[2], w.q[3] };
+    const jc_v4f q1 = { 0.0f,   w.q[0], w.q[1], w.q[2] };
+    const jc_v4f q2 = { 0.0f,   0.0f,   w.q[0], w.q[1] };
+    const jc_v4f q3 = { 0.0f,   0.0f,   0.0f,   w.q[0] };
+    float s = f->state;
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        jc_v4f acc = q0 * x[i] + q1 * x[i + 1] + q2 * x[i + 2] + q3 * x[i + 3];
+        jc_v4f y = p * s + acc;
+        jc_v4f_store(x + i, y);
+        s = y[3];
+    }
+    f->state = s;
+    for (; i < n; i++) x[i] = fo_lpf_process(f, x[i]);
+}
+
+/*
+ * Two filters with the same alpha (the L/R post filters) packed into
+ * one vector as [L0, L1, R0, R1], two frames per step.
+ */
+static inline void fo_lpf_block_stereo(fo_lpf_t *fl, fo_lpf_t *fr, float *l, float *r, int n) {
+    fo_lpf_pow_t w;
+    fo_lpf_pow_init(&w, fl->alpha);
+    const jc_v4f p  = { w.p[0], w.p[1], w.p[0], w.p[1] };
+    const jc_v4f q0 = { w.q[0], w.q[1], w.q[0], w.q[1] };
+    const jc_v4f q1 = { 0.0f,   w.q[0], 0.0f,   w.q[0] };
+    float sl = fl->state;
+    float sr = fr->state;
+    int i = 0;
+
+    for (; i + 2 <= n; i += 2) {
+        jc_v4f x0 = { l[i],     l[i],     r[i],     r[i] };
+        jc_v4f x1 = { l[i + 1], l[i + 1], r[i + 1], r[i + 1] };
+        jc_v4f st = { sl, sl, sr, sr };
+        jc_v4f y = p * st + (q0 * x0 + q1 * x1);
+        l[i] = y[0];
+        l[i + 1] = sl = y[1];
+        r[i] = y[2];
+        r[i + 1] = sr = y[3];
+    }
+    fl->state = sl;
+    fr->state = sr;
+    for (; i < n; i++) {
+        l[i] = fo_lpf_process(fl, l[i]);
+        r[i] = fo_lpf_process(fr, r[i]);
+    }
+}
+
+/* --- Delay line with fractional read --- */
+
+/*
+ * Mirrored ring: every sample is stored at i and i + size, so any
+ * window of up to size samples is contiguous in memory. Writes pay the
+ * mask; tap reads are plain pointer arithmetic from the base returned
+ * by delay_block_base().
+ *
+ * The block pipeline writes a whole chunk before reading any tap, so
+ * the ring is sized at init to hold a chunk plus the longest tap.
+ * qbuf is the same ring in Q15 for the fixed-point engine, allocated
+ * by delay_init_q15 only once that engine is wanted. Only one of the
+ * two is in use at a time, and they share the write position.
+ */
+typedef struct {
+    float *buf;         /* 2 * size floats, cache-line aligned */
+    int16_t *qbuf;      /* 2 * size Q15 samples, cache-line aligned, or NULL */
+    int size;           /* power of 2 */
+    int mask;
+    int reach;          /* longest tap incl. interpolation, in samples */
+    int write_pos;
+} delay_line_t;
+
+/* Allocate for taps up to reach samples; returns 0 on success */
+static inline int delay_init(delay_line_t *d, int reach) {
+    int size = 1;
+    while (size < reach + JC_CHUNK) size <<= 1;
+
+    void *mem = NULL;
+    if (posix_memalign(&mem, JC_CACHE_LINE, 2 * (size_t)size * sizeof(float)) != 0)
+        return -1;
+    memset(mem, 0, 2 * (size_t)size * sizeof(float));
+
+    d->buf = (float *)mem;
+    d->qbuf = NULL;
+    d->size = size;
+    d->mask = size - 1;
+    d->reach = reach;
+    d->write_pos = 0;
+    return 0;
+}
+
+/* Add the zeroed Q15 ring if it is not there yet; returns 0 on success */
+static inline int delay_init_q15(delay_line_t *d) {
+    if (d->qbuf) return 0;
+
+    void *mem = NULL;
+    if (posix_memalign(&mem, JC_CACHE_LINE, 2 * (size_t)d->size * sizeof(int16_t)) != 0)
+        return -1;
+    memset(mem, 0, 2 * (size_t)d->size * sizeof(int16_t));
+    d->qbuf = (int16_t *)mem;
+    return 0;
+}
+
+static inline void delay_clear(delay_line_t *d) {
+    memset(d->buf, 0, 2 * (size_t)d->size * sizeof(float));
+    d->write_pos = 0;
+}
+
+static inline void delay_clear_q15(delay_line_t *d) {
+    memset(d->qbuf, 0, 2 * (size_t)d->size * sizeof(int16_t));
+    d->write_pos = 0;
+}
+
+static inline void delay_free(delay_line_t *d) {
+    free(d->buf);
+    free(d->qbuf);
+    d->buf = NULL;
+    d->qbuf = NULL;
+}
+
+/* Append n samples; returns the ring index the first one was written to */
+static inline int delay_write_block(delay_line_t *d, const float *x, int n) {
+    int start = d->write_pos;
+    for (int i = 0; i < n; i++) {
+        int k = (start + i) & d->mask;
+        d->buf[k] = x[i];
+        d->buf[k + d->size] = x[i];
+    }
+    d->write_pos = (start + n) & d->mask;
+    return start;
+}
+
+/*
+ * Pointer p such that p[j] is the sample written at ring index start + j,
+ * valid for j in [-reach, JC_CHUNK). Picks whichever copy keeps that
+ * window inside the mirrored buffer.
+ */
+static inline const float *delay_block_base(const delay_line_t *d, int start) {
+    if (start >= d->reach)
+        return d->buf + start;
+    return d->buf + start + d->size;
+}
+
+/* Q15 counterparts of delay_write_block / delay_block_base */
+static inline int delay_write_block_q15(delay_line_t *d, const int16_t *x, int n) {
+    int start = d->write_pos;
+    for (int i = 0; i < n; i++) {
+        int k = (start + i) & d->mask;
+        d->qbuf[k] = x[i];
+        d->qbuf[k + d->size] = x[i];
+    }
+    d->write_pos = (start + n) & d->mask;
+    return start;
+}
+
+static inline const int16_t *delay_block_base_q15(const delay_line_t *d, int start) {
+    if (start >= d->reach)
+        return d->qbuf + start;
+    return d->qbuf + start + d->size;
+}
+
+/* Read delay_samples behind p, where p points at the current frame */
+static inline float delay_read_frac(const float *p, float delay_samples) {
+    int di = (int)delay_samples;
+    float frac = delay_samples - (float)di;
+    return p[-di] * (1.0f - frac) + p[-di - 1] * frac;
+}
+
+/* delay_read_frac for frames p[0..3], one delay per lane */
+static inline jc_v4f delay_read_frac_v4(const float *p, jc_v4f delay_samples) {
+    const jc_v4i lane = { 0, 1, 2, 3 };
+    jc_v4i di = jc_v4f_to_v4i(delay_samples);
+    jc_v4f frac = delay_samples - jc_v4i_to_v4f(di);
+    jc_v4i idx = lane - di;
+    return jc_v4f_gather(p, idx) * (1.0f - frac) + jc_v4f_gather(p, idx - 1) * frac;
+}
+
+/*
+ * 4-point, 3rd-order Hermite read. Flatter passband than linear and
+ * no modulation-dependent lowpass; reads one sample either side of
+ * the linear pair, so taps need reach for delay + 2.
+ */
+static inline float delay_read_hermite(const float *p, float delay_samples) {
+    int di = (int)delay_samples;
+    float t = delay_samples - (float)di;
+    float xm1 = p[-di + 1];
+    float x0  = p[-di];
+    float x1  = p[-di - 1];
+    float x2  = p[-di - 2];
+    float c1 = 0.5f * (x1 - xm1);
+    float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+    float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+    return ((c3 * t + c2) * t + c1) * t + x0;
+}
+
+/* delay_read_hermite for frames p[0..3], one delay per lane */
+static inline jc_v4f delay_read_hermite_v4(const float *p, jc_v4f delay_samples) {
+    const jc_v4i lane = { 0, 1, 2, 3 };
+    jc_v4i di = jc_v4f_to_v4i(delay_samples);
+    jc_v4f t = delay_samples - jc_v4i_to_v4f(di);
+    jc_v4i idx = lane - di;
+    jc_v4f xm1 = jc_v4f_gather(p, idx + 1);
+    jc_v4f x0  = jc_v4f_gather(p, idx);
+    jc_v4f x1  = jc_v4f_gather(p, idx - 1);
+    jc_v4f x2  = jc_v4f_gather(p, idx - 2);
+    jc_v4f c1 = 0.5f * (x1 - xm1);
+    jc_v4f c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+    jc_v4f c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+    return ((c3 * t + c2) * t + c1) * t + x0;
+}
+
+/*
+ * First-order Thiran allpass read: unity magnitude at all frequencies,
+ * the fraction becomes phase delay instead. The fraction is kept in
+ * [0.5, 1.5) where the allpass is best behaved. *y1 is the tap's
+ * allpass state; a jump in the integer part leaves a small transient,
+ * which the slow chorus sweep keeps rare.
+ */
+static inline float delay_read_thiran(const float *p, float delay_samples, float *y1) {
+    int di = (int)(delay_samples - 0.5f);
+    float d = delay_samples - (float)di;
+    float eta = (1.0f - d) / (1.0f + d);
+    float y = eta * (p[-di] - *y1) + p[-di - 1];
+    *y1 = y;
+    return y;
+}
+
+/*
+ * delay_read_thiran for four taps of the frame at p, one tap and its
+ * allpass state per lane. The state recurs frame to frame, so the
+ * lanes are taps rather than frames.
+ */
+static inline jc_v4f delay_read_thiran_v4(const float *p, jc_v4f delay_samples, jc_v4f *y1) {
+    jc_v4i di = jc_v4f_to_v4i(delay_samples - 0.5f);
+    jc_v4f d = delay_samples - jc_v4i_to_v4f(di);
+    jc_v4f eta = (1.0f - d) / (1.0f + d);
+    jc_v4f y = eta * (jc_v4f_gather(p, -di) - *y1) + jc_v4f_gather(p, -di - 1);
+    *y1 = y;
+    return y;
+}
+
+/* --- Triangle LFO (unipolar 0..1) --- */
+
+/*
+ * 32-bit phase accumulator, wrapping naturally once per cycle. The
+ * increment is the exact rational rate split into a whole part (inc)
+ * and a remainder (inc_frac / den) that is carried Bresenham-style, so
+ * the period is exact over any run length and two instances at the
+ * same rate and phase stay sample-identical.
+ */
+typedef struct {
+    uint32_t phase;
+    uint32_t inc;
+    uint32_t inc_frac;  /* remainder of the increment, in 1/den LSB */
+    uint32_t rem;       /* carried remainder, < den */
+    uint32_t den;
+} lfo_t;
+
+/*
+ * rate_mhz millihertz at sample_rate / decim ticks per second. Phase
+ * carries over; the sub-LSB remainder restarts.
+ */
+static inline void lfo_set_rate(lfo_t *l, uint32_t rate_mhz, uint32_t sample_rate, uint32_t decim) {
+    uint64_t num = ((uint64_t)rate_mhz * decim) << 32;
+    uint64_t den = (uint64_t)sample_rate * 1000u;
+
+    l->inc      = (uint32_t)(num / den);
+    l->inc_frac = (uint32_t)(num % den);
+    l->den      = (uint32_t)den;
+    l->rem      = 0;
+}
+
+static inline void lfo_init(lfo_t *l, uint32_t rate_mhz, uint32_t sample_rate) {
+    l->phase = 0;
+    lfo_set_rate(l, rate_mhz, sample_rate, 1);
+}
+
+/* Advance phase by n ticks without producing values (silent LFO) */
+static inline void lfo_advance(lfo_t *l, int n) {
+    uint64_t acc = (uint64_t)l->rem + (uint64_t)l->inc_frac * (uint32_t)n;
+    l->phase += l->inc * (uint32_t)n + (uint32_t)(acc / l->den);
+    l->rem = (uint32_t)(acc % l->den);
+}
+
+/*
+ * Triangle from phase, branch-free: folding on the top bit rises over
+ * the first half-cycle and falls over the second (0 .. 2^32 - 2).
+ */
+static inline uint32_t lfo_tri(uint32_t p) {
+    return (p ^ (uint32_t)((int32_t)p >> 31)) << 1;
+}
+
+/*
+ * Carry out of the remainder after i ticks: floor((rem + inc_frac * i)
+ * / den), as in lfo_advance. The quotient is taken in double: the sum
+ * is an exact integer and is offset by a half, so the true quotient is
+ * at least 0.5 / den away from an integer, far more than the rounding
+ * of the multiply (and of any reassociation -Ofast applies). Exact for
+ * any i up to millions, and free of carried state, so it vectorizes.
+ */
+typedef struct {
+    uint32_t phase, inc;
+    double   base, frac, inv_den;
+} lfo_run_t;
+
+static inline lfo_run_t lfo_run(const lfo_t *l) {
+    lfo_run_t r = { l->phase, l->inc, (double)l->rem + 0.5, (double)l->inc_frac,
+                    1.0 / (double)l->den };
+    return r;
+}
+
+/* Phase after i ticks */
+static inline uint32_t lfo_run_phase(const lfo_run_t *r, int i) {
+    uint32_t carry = (uint32_t)(int32_t)((r->base + r->frac * (double)i) * r->inv_den);
+    return r->phase + r->inc * (uint32_t)i + carry;
+}
+
+/*
+ * Fill v[0..n) with the next n LFO values (phase advanced before each
+ * one). The top 24 bits of the triangle convert to float exactly.
+ * Every value carries the remainder exactly, so the output depends
+ * only on the tick count, not on how a run is split into blocks.
+ */
+static inline void lfo_fill(lfo_t *l, float *v, int n) {
+    const lfo_run_t r = lfo_run(l);
+
+    for (int i = 0; i < n; i++)
+        v[i] = (float)(lfo_tri(lfo_run_phase(&r, i + 1)) >> 8) * (1.0f / 16777216.0f);
+    lfo_advance(l, n);
+}
+
+/*
+ * The same values in Q31 (the triangle's top 31 bits, 0 .. 2^31 - 1),
+ * for the fixed-point engine
+ */
+static inline void lfo_fill_q31(lfo_t *l, int32_t *v, int n) {
+    const lfo_run_t r = lfo_run(l);
+
+    for (int i = 0; i < n; i++)
+        v[i] = (int32_t)(lfo_tri(lfo_run_phase(&r, i + 1)) >> 1);
+    lfo_advance(l, n);
+}
+
+/* --- Fixed-point primitives --- */
+
+/*
+ * Scalar forms of the NEON saturating ops the fixed-point engine uses,
+ * bit-exact with vqdmulh / vqrdmulh / vqadd / vqrshrn, so the vector
+ * helpers in jc_simd.h and the scalar tails agree. Audio is Q15 in
+ * output LSB units (x32767, as the float path scales its output) in
+ * the ring and Q30 (Q15 << 15) between stages; gains and filter
+ * coefficients are Q31.
+ */
+#define JC_Q_SHIFT 15
+
+static inline int32_t jc_qdmulh_s32(int32_t a, int32_t b) {
+    if (a == INT32_MIN && b == INT32_MIN) return INT32_MAX;
+    return (int32_t)(((int64_t)a * b) >> 31);
+}
+
+static inline int32_t jc_qrdmulh_s32(int32_t a, int32_t b) {
+    if (a == INT32_MIN && b == INT32_MIN) return INT32_MAX;
+    return (int32_t)(((int64_t)a * b + (1 << 30)) >> 31);
+}
+
+static inline int32_t jc_qadd_s32(int32_t a, int32_t b) {
+    int64_t s = (int64_t)a + b;
+    if (s > INT32_MAX) return INT32_MAX;
+    if (s < INT32_MIN) return INT32_MIN;
+    return (int32_t)s;
+}
+
+static inline int16_t jc_qrshrn15_s32(int32_t a) {
+    int64_t v = ((int64_t)a + (1 << 14)) >> 15;
+    if (v > INT16_MAX) return INT16_MAX;
+    if (v < INT16_MIN) return INT16_MIN;
+    return (int16_t)v;
+}
+
+static inline int16_t jc_sat16(int32_t a) {
+    if (a > INT16_MAX) return INT16_MAX;
+    if (a < INT16_MIN) return INT16_MIN;
+    return (int16_t)a;
+}
+
+/* Gain or coefficient in [0, 1] to Q31, 1.0 saturating to 1 - 2^-31 */
+static inline int32_t jc_q31(float x) {
+    if (x >= 1.0f) return INT32_MAX;
+    return (int32_t)(x * 2147483648.0f);
+}
+
+/*
+ * soft_limit() from a Q15 sample to Q30: x * g(x^2), where g(u) =
+ * (27 + u) / (27 + 9u) is fitted by a quartic in u (within 3.4e-6,
+ * under 0.1 LSB at full scale) and run in doubling multiplies. The
+ * coefficients are the quartic's, times 32767 / 2^16, in Q31.
+ */
+JC_TABLE int32_t SOFT_LIMIT_Q31[5] = {
+    1073705414, -317952724, 104527614, -30763980, 5593451
+};
+
+static inline int32_t soft_limit_q30(int32_t x) {
+    int32_t xq = x * 65536;
+    int32_t u = jc_qdmulh_s32(xq, xq);
+    int32_t h = SOFT_LIMIT_Q31[4];
+    for (int k = 3; k >= 0; k--)
+        h = jc_qdmulh_s32(h, u) + SOFT_LIMIT_Q31[k];
+    return jc_qdmulh_s32(xq, h);
+}
+
+/* soft_limit_q30 per lane */
+static inline jc_v4i soft_limit_q30_v4(jc_v4i x) {
+    jc_v4i xq = x * 65536;
+    jc_v4i u = jc_v4i_qdmulh(xq, xq);
+    jc_v4i h = jc_v4i_set1(SOFT_LIMIT_Q31[4]);
+    for (int k = 3; k >= 0; k--)
+        h = jc_v4i_qdmulh(h, u) + SOFT_LIMIT_Q31[k];
+    return jc_v4i_qdmulh(xq, h);
+}
+
+/*
+ * fo_lpf_process on Q30 samples and state with a Q31 coefficient. Wet
+ * samples reach about +-1.1 * 2^30, so x - state can leave int32: it
+ * is taken in int64, and the step, which lies between 0 and x - state,
+ * brings the state no further than x.
+ */
+static inline int32_t fo_lpf_process_q(int32_t *state, int32_t alpha, int32_t x) {
+    *state += (int32_t)(((int64_t)alpha * ((int64_t)x - *state)) >> 31);
+    return *state;
+}
+
+/*
+ * fo_lpf_block's block form in Q31. The powers are taken in double and
+ * rounded once, so p[3] + sum(q) stays within a few 2^-31 of unity and
+ * the DC gain holds however small alpha gets.
+ */
+typedef struct {
+    jc_v4i p;           /* b^(k+1) */
+    jc_v4i q[4];        /* column j: alpha b^(k-j), zero above the diagonal */
+    int32_t alpha;      /* for the per-frame tail */
+} fo_lpf_q_t;
+
+static inline void fo_lpf_q_init(fo_lpf_q_t *c, float alpha) {
+    const double a = alpha >= 1.0f ? 1.0 : (double)alpha;
+    const double b = 1.0 - a;
+    const double pw[5] = { 1.0, b, b * b, b * b * b, b * b * b * b };
+    int32_t p[4], q[4][4];
+    c->alpha = jc_q31(alpha);
+    for (int k = 0; k < 4; k++) {
+        p[k] = (int32_t)fmin(pw[k + 1] * 2147483648.0, 2147483647.0);
+        for (int j = 0; j < 4; j++)
+            q[j][k] = j > k ? 0 : (int32_t)fmin(a * pw[k - j] * 2147483648.0, 2147483647.0);
+    }
+    c->p = jc_v4i_load(p);
+    for (int j = 0; j < 4; j++) c->q[j] = jc_v4i_load(q[j]);
+}
+
+/* fo_lpf_process_q over x[0..n) in place, four frames per vector, sums saturating */
+static inline void fo_lpf_block_q(int32_t *state, const fo_lpf_q_t *c, int32_t *x, int n) {
+    int32_t s = *state;
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        jc_v4i acc = jc_v4i_qdmulh_n(c->q[0], x[i]);
+        acc = jc_v4i_qadd(acc, jc_v4i_qdmulh_n(c->q[1], x[i + 1]));
+        acc = jc_v4i_qadd(acc, jc_v4i_qdmulh_n(c->q[2], x[i + 2]));
+        acc = jc_v4i_qadd(acc, jc_v4i_qdmulh_n(c->q[3], x[i + 3]));
+        jc_v4i y = jc_v4i_qadd(jc_v4i_qdmulh_n(c->p, s), acc);
+        jc_v4i_store(x + i, y);
+        s = y[3];
+    }
+    for (; i < n; i++) x[i] = fo_lpf_process_q(&s, c->alpha, x[i]);
+    *state = s;
+}
+
+/*
+ * Linear read at a 16.16 delay, to Q30; p as for delay_read_frac. The
+ * fraction goes to Q31 for a rounding doubling multiply (vqrdmulh).
+ */
+static inline int32_t delay_read_q30(const int16_t *p, int32_t delay_q16) {
+    int di = delay_q16 >> 16;
+    int32_t frac = (delay_q16 & 0xffff) << 15;
+    int32_t x0 = p[-di] * (1 << JC_Q_SHIFT);
+    int32_t x1 = p[-di - 1] * (1 << JC_Q_SHIFT);
+    return x0 + jc_qrdmulh_s32(x1 - x0, frac);
+}
+
+/* delay_read_q30 for frames p[0..3], one delay per lane */
+static inline jc_v4i delay_read_q30_v4(const int16_t *p, jc_v4i delay_q16) {
+    const jc_v4i lane = { 0, 1, 2, 3 };
+    jc_v4i idx = lane - (delay_q16 >> 16);
+    jc_v4i frac = (delay_q16 & 0xffff) << 15;
+    jc_v4i x0 = jc_v4i_gather_s16(p, idx) * (1 << JC_Q_SHIFT);
+    jc_v4i x1 = jc_v4i_gather_s16(p, idx - 1) * (1 << JC_Q_SHIFT);
+    return x0 + jc_v4i_qrdmulh(x1 - x0, frac);
+}
+
+/* --- Linear parameter ramp --- */
+
+typedef struct {
+    float value;
+    float target;
+    float step;
+    int   left;     /* frames until value reaches target */
+} jc_ramp_t;
+
+/* Jump straight to v (no ramp) */
+static inline void jc_ramp_reset(jc_ramp_t *r, float v) {
+    r->value = r->target = v;
+    r->step = 0.0f;
+    r->left = 0;
+}
+
+/* Move toward target over the next frames frames */
+static inline void jc_ramp_set(jc_ramp_t *r, float target, int frames) {
+    if (target == r->target) return;
+    r->target = target;
+    r->step = (target - r->value) / (float)frames;
+    r->left = frames;
+}
+
+/* Fill out[0..n) with the next n values */
+static inline void jc_ramp_fill(jc_ramp_t *r, float *out, int n) {
+    int m = r->left < n ? r->left : n;
+    for (int i = 0; i < m; i++)
+        out[i] = r->value + r->step * (float)(i + 1);
+    r->left -= m;
+    r->value = r->left ? r->value + r->step * (float)m : r->target;
+    for (int i = m; i < n; i++)
+        out[i] = r->value;
+}
+
+/* jc_ramp_fill as Q31 gains, for the fixed-point engine */
+static inline void jc_ramp_fill_q31(jc_ramp_t *r, int32_t *out, int n) {
+    float v[JC_CHUNK];
+    jc_ramp_fill(r, v, n);
+    for (int i = 0; i < n; i++)
+        out[i] = jc_q31(v[i]);
+}
+
+/* --- 2x halfband resampler --- */
+
+/*
+ * 27-tap Kaiser-windowed (beta 6) halfband: < 0.01 dB ripple up to
+ * fs * 0.18 (8 kHz at 44.1 kHz), > 60 dB rejection of everything that
+ * would alias below it. Only taps at odd distance from the centre are
+ * non-zero, so the decimator is a symmetric 14-tap FIR on the even
+ * inputs plus the 0.5 centre tap, and the interpolator's odd phase is
+ * a pure delay. Each direction has HB_ORDER / 2 samples group delay.
+ */
+#define HB_ORDER 26
+#define HB_COEFS 7
+#define HB_HALF_HIST (2 * HB_COEFS - 1)
+
+JC_TABLE float HB_C[HB_COEFS] = {
+    0.313773334f, -0.093413303f, 0.044410225f, -0.021953155f,
+    0.010003526f, -0.003796743f, 0.000976115f
+};
+
+typedef struct {
+    /* Last HB_ORDER inputs, split by phase as hb_decimate reads them */
+    float ev[HB_ORDER / 2];
+    float od[HB_ORDER / 2];
+    int   parity;               /* index of the next output in a chunk */
+} hb_decim_t;
+
+typedef struct {
+    float hist[HB_HALF_HIST];   /* last HB_HALF_HIST half-rate inputs */
+    float pending;              /* odd-phase output that did not fit */
+    int   has_pending;
+} hb_interp_t;
+
+/*
+ * Decimate n (at most JC_CHUNK) inputs into y; returns the number of
+ * outputs (n/2 rounded either way depending on parity). Polyphase:
+ * output k is the 0.5 centre tap on one phase plus a symmetric FIR
+ * over consecutive samples of the other, four outputs per jc_v4f.
+ * The history is kept split, so only the new inputs are split here;
+ * an odd n moves the split by whole samples, never across phases.
+ */
+static inline int hb_decimate(hb_decim_t *d, const float *x, float *y, int n) {
+    enum { H = HB_ORDER / 2 };
+    float ev[H + JC_CHUNK / 2 + 4] JC_ALIGNED;
+    float od[H + JC_CHUNK / 2 + 4] JC_ALIGNED;
+    const int p = d->parity;
+
+    /* Input i sits at H + (i - p) / 2 in whichever phase it falls in */
+    memcpy(ev, d->ev, sizeof(d->ev));
+    memcpy(od, d->od, sizeof(d->od));
+    float *xe = p ? od + H - 1 : ev + H;
+    float *xo = p ? ev + H : od + H;
+    int t = 0;
+    for (; 2 * t + 8 <= n; t += 4) {
+        jc_v4f a, b;
+        jc_v4f_load2(x + 2 * t, &a, &b);
+        jc_v4f_store(xe + t, a);
+        jc_v4f_store(xo + t, b);
+    }
+    for (; 2 * t < n; t++) {
+        xe[t] = x[2 * t];
+        if (2 * t + 1 < n) xo[t] = x[2 * t + 1];
+    }
+
+    int m = (n - p + 1) >> 1;
+    int k = 0;
+    for (; k + 4 <= m; k += 4) {
+        jc_v4f acc = 0.5f * jc_v4f_load(od + k + HB_COEFS - 1);
+        for (int j = 0; j < HB_COEFS; j++)
+            acc = jc_v4f_madd(jc_v4f_set1(HB_C[j]),
+                              jc_v4f_load(ev + k + HB_COEFS - 1 - j) +
+                              jc_v4f_load(ev + k + HB_COEFS + j), acc);
+        jc_v4f_store(y + k, acc);
+    }
+    for (; k < m; k++) {
+        float acc = 0.5f * od[k + HB_COEFS - 1];
+        for (int j = 0; j < HB_COEFS; j++)
+            acc += HB_C[j] * (ev[k + HB_COEFS - 1 - j] + ev[k + HB_COEFS + j]);
+        y[k] = acc;
+    }
+
+    /* The last HB_ORDER inputs start (n + parity' - p) / 2 further on */
+    int q = (p + n) & 1;
+    int sh = (n + q - p) >> 1;
+    memcpy(d->ev, ev + sh, sizeof(d->ev));
+    memcpy(d->od, od + sh, (size_t)(H - q) * sizeof(float));
+    d->parity = q;
+    return m;
+}
+
+/*
+ * Interpolate m half-rate inputs per channel into exactly n outputs.
+ * Paired with hb_decimate on the same chunks, 2 * m plus any pending
+ * sample is always n or n + 1; the extra one is carried to the next
+ * chunk. Both channels share m and n, so they run in one pass and
+ * their pending flags stay equal. The even phase is a symmetric FIR
+ * over consecutive inputs, four per jc_v4f, stored interleaved with
+ * the odd phase (a pure delay). y may alias out: the inputs are
+ * copied behind the history before any output is written.
+ */
+static inline void hb_interpolate_stereo(hb_interp_t *sl, hb_interp_t *sr,
+                                         const float *yl, const float *yr, int m,
+                                         float *outl, float *outr, int n) {
+    float el[HB_HALF_HIST + JC_CHUNK / 2 + 1] JC_ALIGNED;
+    float er[HB_HALF_HIST + JC_CHUNK / 2 + 1] JC_ALIGNED;
+
+    memcpy(el, sl->hist, sizeof(sl->hist));
+    memcpy(er, sr->hist, sizeof(sr->hist));
+    memcpy(el + HB_HALF_HIST, yl, (size_t)m * sizeof(float));
+    memcpy(er + HB_HALF_HIST, yr, (size_t)m * sizeof(float));
+
+    int o = 0;
+    if (sl->has_pending) {
+        outl[o] = sl->pending;
+        outr[o] = sr->pending;
+        o++;
+        sl->has_pending = sr->has_pending = 0;
+    }
+
+    /* Input i's taps: e[i + C + j] and e[i + C - 1 - j]; its odd output e[i + C] */
+    const float *bl = el + HB_COEFS;
+    const float *br = er + HB_COEFS;
+    int i = 0;
+    for (; i + 4 <= m && o + 8 <= n; i += 4, o += 8) {
+        jc_v4f evl = jc_v4f_set1(0.0f);
+        jc_v4f evr = jc_v4f_set1(0.0f);
+        for (int j = 0; j < HB_COEFS; j++) {
+            jc_v4f c = jc_v4f_set1(HB_C[j]);
+            evl = jc_v4f_madd(c, jc_v4f_load(bl + i + j) + jc_v4f_load(bl + i - 1 - j), evl);
+            evr = jc_v4f_madd(c, jc_v4f_load(br + i + j) + jc_v4f_load(br + i - 1 - j), evr);
+        }
+        jc_v4f_store2(outl + o, 2.0f * evl, jc_v4f_load(bl + i));
+        jc_v4f_store2(outr + o, 2.0f * evr, jc_v4f_load(br + i));
+    }
+    for (; i < m; i++) {
+        float evl = 0.0f, evr = 0.0f;
+        for (int j = 0; j < HB_COEFS; j++) {
+            evl += HB_C[j] * (bl[i + j] + bl[i - 1 - j]);
+            evr += HB_C[j] * (br[i + j] + br[i - 1 - j]);
+        }
+        outl[o] = 2.0f * evl;
+        outr[o] = 2.0f * evr;
+        o++;
+
+        if (o < n) {
+            outl[o] = bl[i];
+            outr[o] = br[i];
+            o++;
+        } else {
+            sl->pending = bl[i];
+            sr->pending = br[i];
+            sl->has_pending = sr->has_pending = 1;
+        }
+    }
+
+    memcpy(sl->hist, el + m, sizeof(sl->hist));
+    memcpy(sr->hist, er + m, sizeof(sr->hist));
+}
+
+/*
+ * Advance either side by a chunk without filtering, keeping the
+ * decimator parity and interpolator pending flag in step.
+ * hb_decim_skip returns the half-rate count m and leaves the history
+ * stale. hb_interp_skip takes the last k = min(m, HB_HALF_HIST) of the
+ * m inputs in tail, which is enough to leave the history and any
+ * pending output as filtering would have.
+ */
+static inline int hb_decim_skip(hb_decim_t *d, int n) {
+    int m = (n - d->parity + 1) >> 1;
+    d->parity = (d->parity + n) & 1;
+    return m;
+}
+
+static inline void hb_interp_skip(hb_interp_t *s, const float *tail, int k, int m, int n) {
+    if (k) {
+        memmove(s->hist, s->hist + k, (size_t)(HB_HALF_HIST - k) * sizeof(float));
+        memcpy(s->hist + HB_HALF_HIST - k, tail, (size_t)k * sizeof(float));
+    }
+    s->has_pending += 2 * m - n;
+    s->pending = s->hist[HB_HALF_HIST - HB_COEFS];   /* last odd output */
+}
+
+/* --- Bucket-brigade delay line --- */
+
+/*
+ * Clocked BBD model of the MN3009 (256 stages, so the delay is 128
+ * clock periods). The modulated delay sets the clock rate rather than
+ * a read position: every clock tick samples the input at the tick
+ * instant into the bucket chain and releases the oldest bucket, which
+ * is held until the next tick. The aliasing from the variable-rate
+ * sampling and the zero-order-hold imaging both reach the post-filter,
+ * as they do on the hardware.
+ *
+ * The chip's input (anti-alias) and output (reconstruction) filters
+ * follow Holters & Parker, "A combined model for a bucket brigade
+ * device and its input and output filters" (DAFx 2018): each filter
+ * is split into complex one-poles, H(s) = sum r / (s - p), so it can
+ * be evaluated between samples. The input bank runs at the sample rate
+ * and is read out at each tick instant; the output bank takes the
+ * steps of the held output at each tick and is read out at the sample
+ * instants. Both are 4th-order Butterworth lowpasses at BBD_FILTER_HZ,
+ * just under the first clock image at the longest delay. Only one pole
+ * of each conjugate pair is kept, with the real part doubled, and the
+ * tick-dependent gains come from tables over the tick offset with
+ * linear interpolation.
+ *
+ * Each bank keeps its two poles in one jc_v4f, {re0, re1, im0, im1},
+ * so a complex step is two multiplies and a half swap. A table step
+ * holds the input and output gains and their slopes to the next step
+ * in one cache line, and a tick looks up one step for both banks.
+ *
+ * At the Juno delay range the clock runs at 0.54-1.75 ticks per
+ * sample. The clock divide runs once per chunk on vectors
+ * (bbd_clock_block), so per sample a line costs one output bank step
+ * and at most two ticks; the input bank is shared by all lines.
+ */
+#define BBD_STAGES    128
+#define BBD_FILTER_HZ 9000.0
+#define BBD_POLES     2         /* conjugate pairs: 4th order */
+#define BBD_TAB       64        /* tick-offset table steps */
+
+/* Gains at one tick offset, and their change to the next step */
+typedef struct {
+    jc_v4f gin, gin_d;      /* 2 T r e^(p d T): input bank read d samples after its last update */
+    jc_v4f gout, gout_d;    /* 2 r/p e^(p (1 - d) T): output step d samples into the interval */
+} bbd_step_t;
+
+/* Rate-dependent filter constants, shared by every line of an instance */
+typedef struct {
+    jc_v4f a_re;            /* e^(p T): {re0, re1, re0, re1} */
+    jc_v4f a_im;            /* {im0, im1, -im0, -im1} */
+    bbd_step_t tab[BBD_TAB + 1];
+} bbd_filter_t;
+
+/*
+ * Input bank state, advanced once per sample. Held conjugated,
+ * {re0, re1, -im0, -im1}, so a readout is a dot product with the gains.
+ */
+typedef struct {
+    jc_v4f x;
+} bbd_input_t;
+
+typedef struct {
+    float  bucket[BBD_STAGES];
+    int    pos;
+    float  clk;                         /* clock phase since the last tick, in periods */
+    float  held;                        /* held output */
+    jc_v4f y;                           /* output bank state */
+} bbd_line_t;
+
+/* {re0, re1, im0, im1} -> {im0, im1, re0, re1} */
+static inline jc_v4f bbd_swap(jc_v4f v) {
+    return JC_SHUFFLE4(v, v, 2, 3, 0, 1);
+}
+
+/* Butterworth pole k (upper half plane) at cutoff wc, and its residue */
+static inline void bbd_pole(int k, double wc, double *p_re, double *p_im,
+                            double *r_re, double *r_im) {
+    const int order = 2 * BBD_POLES;
+    double pr[2 * BBD_POLES], pi[2 * BBD_POLES];
+
+    for (int j = 0; j < order; j++) {
+        double th = M_PI * 0.5 + M_PI * (2 * j + 1) / (2.0 * order);
+        pr[j] = wc * cos(th);
+        pi[j] = wc * sin(th);
+    }
+    /* r_k = wc^N / prod_{j != k} (p_k - p_j) */
+    double nr = pow(wc, order), ni = 0.0;
+    for (int j = 0; j < order; j++) {
+        if (j == k) continue;
+        double dr = pr[k] - pr[j], di = pi[k] - pi[j];
+        double m = dr * dr + di * di;
+        double tr = (nr * dr + ni * di) / m;
+        ni = (ni * dr - nr * di) / m;
+        nr = tr;
+    }
+    *p_re = pr[k]; *p_im = pi[k];
+    *r_re = nr;    *r_im = ni;
+}
+
+static inline void bbd_filter_init(bbd_filter_t *f, float sample_rate) {
+    const double T = 1.0 / sample_rate;
+    float a[4], gin[BBD_TAB + 1][4], gout[BBD_TAB + 1][4];
+
+    for (int k = 0; k < BBD_POLES; k++) {
+        double p_re, p_im, r_re, r_im;
+        bbd_pole(k, 2.0 * M_PI * BBD_FILTER_HZ, &p_re, &p_im, &r_re, &r_im);
+
+        /* r / p */
+        double m = p_re * p_re + p_im * p_im;
+        double q_re = (r_re * p_re + r_im * p_im) / m;
+        double q_im = (r_im * p_re - r_re * p_im) / m;
+
+        a[k]             = (float)(exp(p_re * T) * cos(p_im * T));
+        a[k + BBD_POLES] = (float)(exp(p_re * T) * sin(p_im * T));
+        for (int j = 0; j <= BBD_TAB; j++) {
+            double d = (double)j / BBD_TAB;
+            double e = exp(p_re * d * T), c = cos(p_im * d * T), s = sin(p_im * d * T);
+            gin[j][k]             = (float)(2.0 * T * e * (r_re * c - r_im * s));
+            gin[j][k + BBD_POLES] = (float)(2.0 * T * e * (r_re * s + r_im * c));
+            e = exp(p_re * (1.0 - d) * T);
+            c = cos(p_im * (1.0 - d) * T);
+            s = sin(p_im * (1.0 - d) * T);
+            gout[j][k]             = (float)(2.0 * e * (q_re * c - q_im * s));
+            gout[j][k + BBD_POLES] = (float)(2.0 * e * (q_re * s + q_im * c));
+        }
+    }
+
+    f->a_re = (jc_v4f){ a[0], a[1], a[0], a[1] };
+    f->a_im = (jc_v4f){ a[2], a[3], -a[2], -a[3] };
+    for (int j = 0; j <= BBD_TAB; j++) {
+        int next = j < BBD_TAB ? j + 1 : j;
+        f->tab[j].gin    = jc_v4f_load(gin[j]);
+        f->tab[j].gin_d  = jc_v4f_load(gin[next]) - f->tab[j].gin;
+        f->tab[j].gout   = jc_v4f_load(gout[j]);
+        f->tab[j].gout_d = jc_v4f_load(gout[next]) - f->tab[j].gout;
+    }
+}
+
+/*
+ * Samples for both banks' impulse responses to fall below silence
+ * (relative to a unit input), bounded by the sum of pole magnitudes
+ */
+static inline int bbd_filter_decay_frames(const bbd_filter_t *f, float silence) {
+    for (int n = 0; n < 100000; n++) {
+        float bound = 0.0f;
+        for (int k = 0; k < BBD_POLES; k++) {
+            float mag = sqrtf(f->a_re[k] * f->a_re[k] + f->a_im[k] * f->a_im[k]);
+            float g = fabsf(f->tab[0].gin[k]) + fabsf(f->tab[0].gin[k + BBD_POLES]) +
+                      fabsf(f->tab[BBD_TAB].gout[k]) + fabsf(f->tab[BBD_TAB].gout[k + BBD_POLES]);
+            bound += g * powf(mag, (float)n);
+        }
+        if (bound < silence) return n;
+    }
+    return 100000;
+}
+
+/*
+ * Clock settings for delays base + scale * v[i] samples: ticks per
+ * sample, and the table span of one clock period (BBD_TAB periods per
+ * sample). Run once per chunk so a line pays no divide per sample.
+ */
+static inline void bbd_clock_block(const float *v, float base, float scale,
+                                   float *ticks, float *span, int n) {
+    const jc_v4f vb = jc_v4f_set1(base);
+    const jc_v4f vs = jc_v4f_set1(scale);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        jc_v4f d = jc_v4f_madd(vs, jc_v4f_load(v + i), vb);
+        jc_v4f_store(ticks + i, jc_v4f_set1((float)BBD_STAGES) / d);
+        jc_v4f_store(span + i, d * jc_v4f_set1((float)BBD_TAB / (float)BBD_STAGES));
+    }
+    for (; i < n; i++) {
+        float d = base + scale * v[i];
+        ticks[i] = (float)BBD_STAGES / d;
+        span[i] = d * ((float)BBD_TAB / (float)BBD_STAGES);
+    }
+}
+
+/* After every line has run for this sample: feed the sample in */
+static inline void bbd_input_push(const bbd_filter_t *f, bbd_input_t *in, float x) {
+    const jc_v4f xv = { x, x, 0.0f, 0.0f };
+    in->x = f->a_re * in->x + f->a_im * bbd_swap(in->x) + xv;
+}
+
+/*
+ * Advance by one sample at the clock from bbd_clock_block. The input
+ * bank still holds the previous sample, so ticks read it
+ * d = 1 - ph * period samples later.
+ */
+static inline float bbd_process(bbd_line_t *b, const bbd_filter_t *f,
+                                const bbd_input_t *in, float ticks, float span) {
+    float ph = b->clk + ticks;
+
+    /* Carry the output bank to this sample instant */
+    jc_v4f y = f->a_re * b->y - f->a_im * bbd_swap(b->y);
+
+    while (ph >= 1.0f) {
+        ph -= 1.0f;
+        /* The tick fell ph periods before this sample; ph < ticks keeps j in the table */
+        float fi = (float)BBD_TAB - ph * span;
+        int j = (int)fi;
+        const bbd_step_t *s = &f->tab[j];
+        const jc_v4f fr = jc_v4f_set1(fi - (float)j);
+
+        jc_v4f g = jc_v4f_madd(fr, s->gin_d, s->gin) * in->x;
+        g = g + bbd_swap(g);
+        float x = g[0] + g[1];
+
+        float out = b->bucket[b->pos];
+        b->bucket[b->pos] = x;
+        b->pos = (b->pos + 1) & (BBD_STAGES - 1);
+        y = jc_v4f_madd(jc_v4f_set1(out - b->held), jc_v4f_madd(fr, s->gout_d, s->gout), y);
+        b->held = out;
+    }
+    b->clk = ph;
+    b->y = y;
+
+    return b->held + y[0] + y[1];
+}
+
+/* --- Interleaved int16 <-> planar float conversion --- */
+
+/*
+ * Both directions run eight frames per step on jc_simd.h vectors
+ * (deinterleave, widen/convert, clamp, saturating narrow) with a
+ * scalar tail, and the vector path matches the scalar one bit for bit
+ * on every target. Input is exact (x / 32768); output clamps to
+ * [-1, 1] before scaling, so negative overload gives -32767 both ways.
+ */
+static inline void jc_s16_to_f32(const int16_t *in, float *l, float *r, int n) {
+    const jc_v4f scale = jc_v4f_set1(1.0f / 32768.0f);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        jc_v8s vl, vr;
+        jc_v8s_load2(in + i * 2, &vl, &vr);
+        jc_v4f_store(l + i,     jc_v4i_to_v4f(jc_v8s_lo(vl)) * scale);
+        jc_v4f_store(l + i + 4, jc_v4i_to_v4f(jc_v8s_hi(vl)) * scale);
+        jc_v4f_store(r + i,     jc_v4i_to_v4f(jc_v8s_lo(vr)) * scale);
+        jc_v4f_store(r + i + 4, jc_v4i_to_v4f(jc_v8s_hi(vr)) * scale);
+    }
+    for (; i < n; i++) {
+        l[i] = (float)in[i * 2]     / 32768.0f;
+        r[i] = (float)in[i * 2 + 1] / 32768.0f;
+    }
+}
+
+/* Clamp to [-1, 1], scale and truncate: jc_f32_to_s16 on four lanes */
+static inline jc_v4i jc_f32_to_s16_v4(jc_v4f x) {
+    x = jc_v4f_min(jc_v4f_max(x, jc_v4f_set1(-1.0f)), jc_v4f_set1(1.0f));
+    return jc_v4f_to_v4i(x * jc_v4f_set1(32767.0f));
+}
+
+static inline void jc_f32_to_s16(const float *l, const float *r, int16_t *out, int n) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        jc_v8s vl = jc_v8s_narrow(jc_f32_to_s16_v4(jc_v4f_load(l + i)),
+                                  jc_f32_to_s16_v4(jc_v4f_load(l + i + 4)));
+        jc_v8s vr = jc_v8s_narrow(jc_f32_to_s16_v4(jc_v4f_load(r + i)),
+                                  jc_f32_to_s16_v4(jc_v4f_load(r + i + 4)));
+        jc_v8s_store2(out + i * 2, vl, vr);
+    }
+    for (; i < n; i++) {
+        float out_l = l[i];
+        float out_r = r[i];
+        if (out_l >  1.0f) out_l =  1.0f;
+        if (out_l < -1.0f) out_l = -1.0f;
+        if (out_r >  1.0f) out_r =  1.0f;
+        if (out_r < -1.0f) out_r = -1.0f;
+        out[i * 2]     = (int16_t)(out_l * 32767.0f);
+        out[i * 2 + 1] = (int16_t)(out_r * 32767.0f);
+    }
+}
+
+/* --- Interleaved float <-> planar float --- */
+
+static inline void jc_f32i_to_f32(const float *in, float *l, float *r, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        jc_v4f vl, vr;
+        jc_v4f_load2(in + i * 2, &vl, &vr);
+        jc_v4f_store(l + i, vl);
+        jc_v4f_store(r + i, vr);
+    }
+    for (; i < n; i++) {
+        l[i] = in[i * 2];
+        r[i] = in[i * 2 + 1];
+    }
+}
+
+/* No clamp: float hosts keep their own headroom */
+static inline void jc_f32_to_f32i(const float *l, const float *r, float *out, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        jc_v4f_store2(out + i * 2, jc_v4f_load(l + i), jc_v4f_load(r + i));
+    for (; i < n; i++) {
+        out[i * 2]     = l[i];
+        out[i * 2 + 1] = r[i];
+    }
+}
+
+#endif /* JC_DSP_H */
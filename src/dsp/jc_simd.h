@@ -0,0 +1,349 @@
+/*
+ * jc_simd.h - portable 128-bit vectors for the Junologue Chorus DSP
+ *
+ * A thin layer over GCC/Clang vector extensions, so a stage written
+ * once compiles to NEON on the Move and to SSE/AVX on x86 (and to
+ * plain scalar code anywhere else). Arithmetic on the types uses the
+ * ordinary operators; the helpers here cover what the operators don't:
+ * unaligned load/store, 2-way (de)interleave, gather, min/max,
+ * widening and saturating narrowing, and the Q15 saturating ops.
+ *
+ * Where the generic lowering would be poor, or where exact rounding
+ * and saturation matter, a helper uses the NEON (or SSE) instruction
+ * and a vector-extension expression elsewhere. Both are meant to match
+ * the scalar jc_q* helpers in jc_dsp.h bit for bit; tests/test_simd.c
+ * checks that, though on x86 the NEON branches only run against an
+ * emulation of the intrinsics.
+ */
+
+#ifndef JC_SIMD_H
+#define JC_SIMD_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define JC_HAVE_NEON 1
+#else
+#define JC_HAVE_NEON 0
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* One NEON (or SSE) register */
+typedef float   jc_v4f __attribute__((vector_size(16)));
+typedef int32_t jc_v4i __attribute__((vector_size(16)));
+typedef int16_t jc_v8s __attribute__((vector_size(16)));
+
+/* Half width, for widening and narrowing only */
+typedef int16_t jc_v4s __attribute__((vector_size(8)));
+
+/* Unsigned views, for wrapping arithmetic and 32x32 -> 64 products */
+typedef uint32_t jc_v4u __attribute__((vector_size(16)));
+typedef uint64_t jc_v2u __attribute__((vector_size(16)));
+
+/* Lane shuffle of two vectors, indices 0..2N-1 as in __builtin_shufflevector */
+#if defined(__clang__)
+#define JC_SHUFFLE4(a, b, i0, i1, i2, i3) \
+    __builtin_shufflevector(a, b, i0, i1, i2, i3)
+#define JC_SHUFFLE8(a, b, i0, i1, i2, i3, i4, i5, i6, i7) \
+    __builtin_shufflevector(a, b, i0, i1, i2, i3, i4, i5, i6, i7)
+#else
+#define JC_SHUFFLE4(a, b, i0, i1, i2, i3) \
+    __builtin_shuffle(a, b, (jc_v4i){ i0, i1, i2, i3 })
+#define JC_SHUFFLE8(a, b, i0, i1, i2, i3, i4, i5, i6, i7) \
+    __builtin_shuffle(a, b, (jc_v8s){ i0, i1, i2, i3, i4, i5, i6, i7 })
+#endif
+
+/* --- Load, store, broadcast (any alignment) --- */
+
+static inline jc_v4f jc_v4f_load(const float *p) {
+    jc_v4f v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void jc_v4f_store(float *p, jc_v4f v) {
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline jc_v4i jc_v4i_load(const int32_t *p) {
+    jc_v4i v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void jc_v4i_store(int32_t *p, jc_v4i v) {
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline jc_v8s jc_v8s_load(const int16_t *p) {
+    jc_v8s v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline void jc_v8s_store(int16_t *p, jc_v8s v) {
+    memcpy(p, &v, sizeof(v));
+}
+
+static inline jc_v4f jc_v4f_set1(float x) {
+    return (jc_v4f){ x, x, x, x };
+}
+
+static inline jc_v4i jc_v4i_set1(int32_t x) {
+    return (jc_v4i){ x, x, x, x };
+}
+
+/* --- Interleaved stereo: even lanes to a, odd lanes to b --- */
+
+static inline void jc_v4f_load2(const float *p, jc_v4f *a, jc_v4f *b) {
+#if JC_HAVE_NEON
+    float32x4x2_t v = vld2q_f32(p);
+    *a = (jc_v4f)v.val[0];
+    *b = (jc_v4f)v.val[1];
+#else
+    jc_v4f x0 = jc_v4f_load(p);
+    jc_v4f x1 = jc_v4f_load(p + 4);
+    *a = JC_SHUFFLE4(x0, x1, 0, 2, 4, 6);
+    *b = JC_SHUFFLE4(x0, x1, 1, 3, 5, 7);
+#endif
+}
+
+static inline void jc_v4f_store2(float *p, jc_v4f a, jc_v4f b) {
+#if JC_HAVE_NEON
+    float32x4x2_t v = { { (float32x4_t)a, (float32x4_t)b } };
+    vst2q_f32(p, v);
+#else
+    jc_v4f_store(p,     JC_SHUFFLE4(a, b, 0, 4, 1, 5));
+    jc_v4f_store(p + 4, JC_SHUFFLE4(a, b, 2, 6, 3, 7));
+#endif
+}
+
+static inline void jc_v8s_load2(const int16_t *p, jc_v8s *a, jc_v8s *b) {
+#if JC_HAVE_NEON
+    int16x8x2_t v = vld2q_s16(p);
+    *a = (jc_v8s)v.val[0];
+    *b = (jc_v8s)v.val[1];
+#else
+    jc_v8s x0 = jc_v8s_load(p);
+    jc_v8s x1 = jc_v8s_load(p + 8);
+    *a = JC_SHUFFLE8(x0, x1, 0, 2, 4, 6, 8, 10, 12, 14);
+    *b = JC_SHUFFLE8(x0, x1, 1, 3, 5, 7, 9, 11, 13, 15);
+#endif
+}
+
+static inline void jc_v8s_store2(int16_t *p, jc_v8s a, jc_v8s b) {
+#if JC_HAVE_NEON
+    int16x8x2_t v = { { (int16x8_t)a, (int16x8_t)b } };
+    vst2q_s16(p, v);
+#else
+    jc_v8s_store(p,     JC_SHUFFLE8(a, b, 0, 8, 1, 9, 2, 10, 3, 11));
+    jc_v8s_store(p + 8, JC_SHUFFLE8(a, b, 4, 12, 5, 13, 6, 14, 7, 15));
+#endif
+}
+
+/* --- 4x4 transpose: r[j][l] <-> r[l][j] --- */
+
+static inline void jc_v4f_transpose4(jc_v4f r[4]) {
+    jc_v4f t0 = JC_SHUFFLE4(r[0], r[1], 0, 4, 1, 5);
+    jc_v4f t1 = JC_SHUFFLE4(r[0], r[1], 2, 6, 3, 7);
+    jc_v4f t2 = JC_SHUFFLE4(r[2], r[3], 0, 4, 1, 5);
+    jc_v4f t3 = JC_SHUFFLE4(r[2], r[3], 2, 6, 3, 7);
+    r[0] = JC_SHUFFLE4(t0, t2, 0, 1, 4, 5);
+    r[1] = JC_SHUFFLE4(t0, t2, 2, 3, 6, 7);
+    r[2] = JC_SHUFFLE4(t1, t3, 0, 1, 4, 5);
+    r[3] = JC_SHUFFLE4(t1, t3, 2, 3, 6, 7);
+}
+
+/* --- Gather --- */
+
+/* p[idx[k]] per lane; NEON has no gather, so it is four loads either way */
+static inline jc_v4f jc_v4f_gather(const float *p, jc_v4i idx) {
+    return (jc_v4f){ p[idx[0]], p[idx[1]], p[idx[2]], p[idx[3]] };
+}
+
+/* The same from int16 samples, sign-extended */
+static inline jc_v4i jc_v4i_gather_s16(const int16_t *p, jc_v4i idx) {
+    return (jc_v4i){ p[idx[0]], p[idx[1]], p[idx[2]], p[idx[3]] };
+}
+
+/* --- Arithmetic --- */
+
+/* a * b + c; fused on targets with FMA when contraction is on (-Ofast) */
+static inline jc_v4f jc_v4f_madd(jc_v4f a, jc_v4f b, jc_v4f c) {
+    return a * b + c;
+}
+
+static inline jc_v4f jc_v4f_min(jc_v4f a, jc_v4f b) {
+#if JC_HAVE_NEON
+    return (jc_v4f)vminq_f32((float32x4_t)a, (float32x4_t)b);
+#elif defined(__SSE2__)
+    return (jc_v4f)_mm_min_ps((__m128)a, (__m128)b);
+#else
+    jc_v4i m = a < b;
+    return (jc_v4f)((m & (jc_v4i)a) | (~m & (jc_v4i)b));
+#endif
+}
+
+static inline jc_v4f jc_v4f_max(jc_v4f a, jc_v4f b) {
+#if JC_HAVE_NEON
+    return (jc_v4f)vmaxq_f32((float32x4_t)a, (float32x4_t)b);
+#elif defined(__SSE2__)
+    return (jc_v4f)_mm_max_ps((__m128)a, (__m128)b);
+#else
+    jc_v4i m = a > b;
+    return (jc_v4f)((m & (jc_v4i)a) | (~m & (jc_v4i)b));
+#endif
+}
+
+/* Plain select form: pminsd/pmaxsd with SSE4.1, smin/smax on NEON */
+static inline jc_v4i jc_v4i_min(jc_v4i a, jc_v4i b) {
+    jc_v4i m = a < b;
+    return (m & a) | (~m & b);
+}
+
+static inline jc_v4i jc_v4i_max(jc_v4i a, jc_v4i b) {
+    jc_v4i m = a > b;
+    return (m & a) | (~m & b);
+}
+
+/* --- Conversion --- */
+
+static inline jc_v4f jc_v4i_to_v4f(jc_v4i v) {
+    return __builtin_convertvector(v, jc_v4f);
+}
+
+/* Truncating; lanes must be within int32 range */
+static inline jc_v4i jc_v4f_to_v4i(jc_v4f v) {
+    return __builtin_convertvector(v, jc_v4i);
+}
+
+/* Sign-extend the low or high four lanes */
+static inline jc_v4i jc_v8s_lo(jc_v8s v) {
+#if JC_HAVE_NEON
+    return (jc_v4i)vmovl_s16(vget_low_s16((int16x8_t)v));
+#else
+    jc_v4s h;
+    memcpy(&h, &v, sizeof(h));
+    return __builtin_convertvector(h, jc_v4i);
+#endif
+}
+
+static inline jc_v4i jc_v8s_hi(jc_v8s v) {
+#if JC_HAVE_NEON
+    return (jc_v4i)vmovl_s16(vget_high_s16((int16x8_t)v));
+#else
+    jc_v4s h;
+    memcpy(&h, (const char *)&v + sizeof(h), sizeof(h));
+    return __builtin_convertvector(h, jc_v4i);
+#endif
+}
+
+/* Saturating narrow of lo and hi into one vector (vqmovn, packssdw) */
+static inline jc_v8s jc_v8s_narrow(jc_v4i lo, jc_v4i hi) {
+#if JC_HAVE_NEON
+    return (jc_v8s)vcombine_s16(vqmovn_s32((int32x4_t)lo), vqmovn_s32((int32x4_t)hi));
+#elif defined(__SSE2__)
+    return (jc_v8s)_mm_packs_epi32((__m128i)lo, (__m128i)hi);
+#else
+    const jc_v4i smin = { INT16_MIN, INT16_MIN, INT16_MIN, INT16_MIN };
+    const jc_v4i smax = { INT16_MAX, INT16_MAX, INT16_MAX, INT16_MAX };
+    jc_v4s l = __builtin_convertvector(jc_v4i_min(jc_v4i_max(lo, smin), smax), jc_v4s);
+    jc_v4s h = __builtin_convertvector(jc_v4i_min(jc_v4i_max(hi, smin), smax), jc_v4s);
+    jc_v8s v;
+    memcpy(&v, &l, sizeof(l));
+    memcpy((char *)&v + sizeof(l), &h, sizeof(h));
+    return v;
+#endif
+}
+
+/* --- Q15 saturating ops (vector jc_q* helpers) --- */
+
+/* (a + b) >> 1 without overflow (vhadd) */
+static inline jc_v8s jc_v8s_hadd(jc_v8s a, jc_v8s b) {
+#if JC_HAVE_NEON
+    return (jc_v8s)vhaddq_s16((int16x8_t)a, (int16x8_t)b);
+#else
+    return (a >> 1) + (b >> 1) + (a & b & 1);
+#endif
+}
+
+/* jc_qadd_s32 per lane (vqadd) */
+static inline jc_v4i jc_v4i_qadd(jc_v4i a, jc_v4i b) {
+#if JC_HAVE_NEON
+    return (jc_v4i)vqaddq_s32((int32x4_t)a, (int32x4_t)b);
+#else
+    jc_v4i s = (jc_v4i)((jc_v4u)a + (jc_v4u)b);
+    jc_v4i ov = (~(a ^ b) & (a ^ s)) >> 31;         /* same signs in, other out */
+    jc_v4i sat = (a >> 31) ^ INT32_MAX;
+    return (ov & sat) | (~ov & s);
+#endif
+}
+
+/*
+ * (a * b + rnd) >> 31 per lane, wrapping: vqdmulh (rnd 0) and vqrdmulh
+ * (rnd 2^30) short of their one saturating case, INT32_MIN squared.
+ * Built from unsigned 32x32 -> 64 products (pmuludq on SSE2, which
+ * every x86-64 kernel has), which differ from the signed ones by 2^32
+ * times the other operand wherever an operand is negative. Not used on
+ * NEON.
+ */
+static inline jc_v4i jc_v4i_mulhi31(jc_v4i a, jc_v4i b, uint64_t rnd) {
+    const jc_v2u lo32 = { 0xffffffffu, 0xffffffffu };
+#if defined(__SSE2__)
+    jc_v2u pe = (jc_v2u)_mm_mul_epu32((__m128i)a, (__m128i)b);
+    jc_v2u po = (jc_v2u)_mm_mul_epu32((__m128i)((jc_v2u)a >> 32), (__m128i)((jc_v2u)b >> 32));
+#else
+    jc_v2u pe = ((jc_v2u)a & lo32) * ((jc_v2u)b & lo32);
+    jc_v2u po = ((jc_v2u)a >> 32) * ((jc_v2u)b >> 32);
+#endif
+    pe = (pe + rnd) >> 31;
+    po = (po + rnd) >> 31;
+    jc_v4u r = (jc_v4u)((pe & lo32) | (po << 32));
+    jc_v4u neg = (jc_v4u)((a >> 31) & b) + (jc_v4u)((b >> 31) & a);
+    return (jc_v4i)(r - (neg << 1));
+}
+
+/* jc_qdmulh_s32 per lane (vqdmulh) */
+static inline jc_v4i jc_v4i_qdmulh(jc_v4i a, jc_v4i b) {
+#if JC_HAVE_NEON
+    return (jc_v4i)vqdmulhq_s32((int32x4_t)a, (int32x4_t)b);
+#else
+    return jc_v4i_mulhi31(a, b, 0) ^ ((a == INT32_MIN) & (b == INT32_MIN));
+#endif
+}
+
+/* jc_qdmulh_s32 of each lane with b (vqdmulh by scalar) */
+static inline jc_v4i jc_v4i_qdmulh_n(jc_v4i a, int32_t b) {
+#if JC_HAVE_NEON
+    return (jc_v4i)vqdmulhq_n_s32((int32x4_t)a, b);
+#else
+    return jc_v4i_qdmulh(a, jc_v4i_set1(b));
+#endif
+}
+
+/* jc_qrdmulh_s32 per lane (vqrdmulh) */
+static inline jc_v4i jc_v4i_qrdmulh(jc_v4i a, jc_v4i b) {
+#if JC_HAVE_NEON
+    return (jc_v4i)vqrdmulhq_s32((int32x4_t)a, (int32x4_t)b);
+#else
+    return jc_v4i_mulhi31(a, b, 1u << 30) ^ ((a == INT32_MIN) & (b == INT32_MIN));
+#endif
+}
+
+/* jc_qrshrn15_s32 of lo and hi into one vector (vqrshrn #15) */
+static inline jc_v8s jc_v8s_qrshrn15(jc_v4i lo, jc_v4i hi) {
+#if JC_HAVE_NEON
+    return (jc_v8s)vcombine_s16(vqrshrn_n_s32((int32x4_t)lo, 15),
+                                vqrshrn_n_s32((int32x4_t)hi, 15));
+#else
+    /* Round half up without the overflow of adding 1 << 14 */
+    return jc_v8s_narrow((lo >> 15) + ((lo >> 14) & 1), (hi >> 15) + ((hi >> 14) & 1));
+#endif
+}
+
+#endif /* JC_SIMD_H */
@@ -21,187 +21,621 @@
 #include <string.h>
 #include <math.h>
 #include <stdio.h>
+#include <stdatomic.h>
 
 #include "plugin_api_v1.h"
 
-#define SAMPLE_RATE 44100.0f
+#if defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
 
-/* Delay buffer - power of 2 for efficient masking */
-#define DELAY_BUF_SIZE 512
-#define DELAY_BUF_MASK (DELAY_BUF_SIZE - 1)
+/* Used when the host does not report a sample rate */
+#define DEFAULT_SAMPLE_RATE ((float)MOVE_SAMPLE_RATE)
 
-/*
- * Juno-60 chorus delay times from Andy Harman's measurements:
- * Min delay: 1.66ms, Max delay: 5.35ms (same for both channels)
- * Stereo from inverted LFO modulation between left and right BBDs.
- */
-#define DELAY_MIN_SEC  0.00166f
-#define DELAY_MAX_SEC  0.00535f
+/* Frames per pass of the block pipeline (host block size) */
+#define JC_CHUNK MOVE_FRAMES_PER_BLOCK
 
-/* Pre-computed delay times in samples at 44100 Hz */
-static const float DT_MIN_S = DELAY_MIN_SEC * 44100.0f;   /* ~73.2 samples */
-static const float DT_RNG_S = (DELAY_MAX_SEC - DELAY_MIN_SEC) * 44100.0f; /* ~162.7 samples */
+#include "jc_dsp.h"
+#include "jc_core.h"
 
-/* LFO rates in Hz (from Harman's measurements) */
-static const float LFO_RATE[2] = { 0.513f, 0.863f };
+/* Parameter changes are smoothed over this long */
+#define SMOOTH_SEC     0.0058f
 
-/* Mode gains: [lfo1_gain, lfo2_gain] */
-static const float MODE_GAIN[3][2] = {
-    { 1.0f, 0.0f },                        /* Mode I   */
-    { 0.70710678f, 0.70710678f },           /* Mode I+II */
-    { 0.0f, 1.0f }                          /* Mode II  */
-};
 
 /* ================================================================
- * DSP Primitives
+ * Audio FX API v2 - Instance-based
  * ================================================================ */
 
-/* Soft limiter (Emilie Gillet / stmlib) */
-static inline float soft_limit(float x) {
-    return x * (27.0f + x * x) / (27.0f + 9.0f * x * x);
-}
+static const host_api_v1_t *g_host = NULL;
 
-/* Fast square root via inverse sqrt approximation */
-static inline float fast_sqrt(float x) {
-    if (x <= 0.0f) return 0.0f;
-    float x2 = x * 0.5f;
-    float y = x;
-    int32_t i;
-    memcpy(&i, &y, sizeof(i));
-    i = 0x5f3759df - (i >> 1);
-    memcpy(&y, &i, sizeof(y));
-    y = y * (1.5f - (x2 * y * y));
-    y = y * (1.5f - (x2 * y * y));
-    return 1.0f / y;
-}
+#define AUDIO_FX_API_VERSION_2 2
+
+typedef struct audio_fx_api_v2 {
+    uint32_t api_version;
+    void *(*create_instance)(const char *module_dir, const char *config_json);
+    void (*destroy_instance)(void *instance);
+    void (*process_block)(void *instance, int16_t *audio_inout, int frames);
+    void (*set_param)(void *instance, const char *key, const char *val);
+    int  (*get_param)(void *instance, const char *key, char *buf, int buf_len);
+} audio_fx_api_v2_t;
+
+typedef audio_fx_api_v2_t *(*audio_fx_init_v2_fn)(const host_api_v1_t *host);
 
 /*
- * One-pole lowpass filter with unity DC gain.
+ * Audio FX API v3 - v2 plus an interleaved float entry point.
  *
- * y[n] = y[n-1] + alpha * (x[n] - y[n-1])
+ * Exported as move_audio_fx_init_v3(). The struct starts with the v2
+ * layout, so a v3 table can also be used where v2 is expected. Hosts
+ * chaining several float-capable FX can call process_block_f32 and
+ * skip the int16 round trip between stages. Samples are nominally
+ * in [-1, 1] and are not clamped on output.
+ */
+#define AUDIO_FX_API_VERSION_3 3
+
+typedef struct audio_fx_api_v3 {
+    uint32_t api_version;
+    void *(*create_instance)(const char *module_dir, const char *config_json);
+    void (*destroy_instance)(void *instance);
+    void (*process_block)(void *instance, int16_t *audio_inout, int frames);
+    void (*set_param)(void *instance, const char *key, const char *val);
+    int  (*get_param)(void *instance, const char *key, char *buf, int buf_len);
+    void (*process_block_f32)(void *instance, float *audio_inout, int frames);
+} audio_fx_api_v3_t;
+
+typedef audio_fx_api_v3_t *(*audio_fx_init_v3_fn)(const host_api_v1_t *host);
+
+/*
+ * Audio FX API v4 - v3 plus batched int16 processing.
  *
- * alpha = w / (1 + w)  where w = 2*pi*fc/fs
- * This avoids the tan() instability near Nyquist that the bilinear
- * transform version has, and maintains unity gain at DC.
+ * Exported as move_audio_fx_init_v4(); starts with the v3 layout.
+ * process_blocks_batched runs count instances of this module, each on
+ * its own interleaved int16 buffer of frames frames. There is no float
+ * variant. Only when at least three instances in a group of four are
+ * batchable (float engine, ideal model, linear quality, full rate,
+ * nothing ramping, not bypassed) do they share the SIMD lane kernel;
+ * everything else renders exactly as process_block would. The lane
+ * kernel runs the filters as per-frame recurrences rather than
+ * process_block's block form, so batched output is NOT bit-identical
+ * to process_block: it can differ by 1 LSB. Hosts that need identical
+ * output should call process_block.
  */
+#define AUDIO_FX_API_VERSION_4 4
+
+typedef struct audio_fx_api_v4 {
+    uint32_t api_version;
+    void *(*create_instance)(const char *module_dir, const char *config_json);
+    void (*destroy_instance)(void *instance);
+    void (*process_block)(void *instance, int16_t *audio_inout, int frames);
+    void (*set_param)(void *instance, const char *key, const char *val);
+    int  (*get_param)(void *instance, const char *key, char *buf, int buf_len);
+    void (*process_block_f32)(void *instance, float *audio_inout, int frames);
+    void (*process_blocks_batched)(void **instances, int16_t **audio_inout,
+                                   int count, int frames);
+} audio_fx_api_v4_t;
+
+typedef audio_fx_api_v4_t *(*audio_fx_init_v4_fn)(const host_api_v1_t *host);
+
+/* LPF cutoff ranges in Hz - clamped below Nyquist */
+#define PRE_LPF_MIN   2000.0f
+#define PRE_LPF_MAX   20000.0f
+#define POST_LPF_MIN  6000.0f
+#define POST_LPF_MAX  20000.0f
+
+/*
+ * Silence threshold (-120 dBFS). An instance whose input stays below it
+ * long enough for the wet tail to drain goes idle and skips its chunks.
+ */
+#define JC_SILENCE 1e-6f
+
+/* Idle state machine (audio thread) */
+#define JC_RUN_ACTIVE 0     /* input present */
+#define JC_RUN_TAIL   1     /* input silent, tail still draining */
+#define JC_RUN_IDLE   2     /* drained: chunks pass through untouched */
+
+/* Sample processing engines */
+#define JC_ENGINE_FLOAT 0
+#define JC_ENGINE_FIXED 1   /* Q15: ideal model, linear taps, full rate */
+
+/* Delay engines */
+#define JC_MODEL_IDEAL 0    /* fractional read from a sampled delay ring */
+#define JC_MODEL_BBD   1    /* clocked bucket-brigade emulation */
+
+struct jc_instance;
+
+/* BBD stage specialized per mode: (inst, frames) */
+typedef void (*jc_bbd_stage_fn)(struct jc_instance *inst, int n);
+
+/*
+ * Process kernel: the block pipeline compiled for one instruction set.
+ * render_* run one chunk in place; taps_bbd holds that kernel's copies
+ * of the BBD stages, core its build of the ideal model's tap stages.
+ */
+typedef struct {
+    const char *name;
+    int  (*supported)(void);
+    void (*render_s16)(struct jc_instance *inst, int16_t *io, int n);
+    void (*render_f32)(struct jc_instance *inst, float *io, int n);
+    void (*render_s16_lanes)(struct jc_instance *const *lane, int16_t *const *io,
+                             int count, int n);
+    const jc_bbd_stage_fn *taps_bbd;            /* [mode or ramp] */
+    const jc_core_kernel_t *core;
+} jc_kernel_t;
+
+/* Everything the audio thread derives from the user parameters */
 typedef struct {
-    float alpha;
-    float state;
-} fo_lpf_t;
+    float gain_a;       /* LFO1 tap gain */
+    float gain_b;       /* LFO2 tap gain */
+    float dry_g;        /* equal-power dry gain */
+    float wet_g;        /* equal-power wet gain */
+    float pre_alpha;
+    float post_alpha;
+    int   half_rate;    /* run ring and taps at half the sample rate */
+    int   model;        /* JC_MODEL_* */
+    int   quality;      /* JC_INTERP_* */
+    int   tail_frames;  /* silent input frames before the wet path drains */
+    int   engine;       /* JC_ENGINE_* for int16 blocks, after fallback */
+    jc_core_tap_fn     tap_stage;       /* ideal model */
+    jc_core_tap_fn     tap_stage_ramp;  /* while the mode gains move */
+    jc_core_tap_q15_fn tap_stage_q15;   /* fixed-point engine */
+    jc_core_tap_q15_fn tap_stage_q15_ramp;
+    jc_bbd_stage_fn    bbd_stage;       /* BBD model */
+    jc_bbd_stage_fn    bbd_stage_ramp;
+} jc_params_t;
+
+/*
+ * Triple buffer handing jc_params_t from the control thread
+ * (set_param) to the audio thread (process_block) without locks.
+ *
+ * The control thread owns slot[back], the audio thread owns
+ * slot[front], and the third slot is parked in `middle`. Publishing
+ * fills the back slot and swaps it into the middle with a dirty flag;
+ * the audio thread swaps the middle into front once per block if it is
+ * dirty. Neither side ever waits or touches the other's slot, so a
+ * snapshot is always read whole. Assumes a single control thread.
+ */
+#define JC_PARAMS_DIRTY 4u
 
-static void fo_lpf_init(fo_lpf_t *f) {
-    f->alpha = 1.0f;   /* pass-through until set */
-    f->state = 0.0f;
+typedef struct {
+    jc_params_t slot[3];
+    atomic_uint middle;     /* slot index | JC_PARAMS_DIRTY */
+    unsigned    back;       /* control thread only */
+    unsigned    front;      /* audio thread only */
+} jc_params_xchg_t;
+
+static void jc_params_xchg_init(jc_params_xchg_t *x) {
+    x->front = 0;
+    x->back  = 1;
+    atomic_init(&x->middle, 2u);
 }
 
-static void fo_lpf_set_cutoff(fo_lpf_t *f, float hz) {
-    if (hz <= 0.0f) {
-        f->alpha = 0.0f;
-        return;
-    }
-    /* Clamp to below Nyquist */
-    if (hz >= SAMPLE_RATE * 0.49f) {
-        f->alpha = 1.0f;
+/* Control thread: fill and return the slot to publish next */
+static jc_params_t *jc_params_back(jc_params_xchg_t *x) {
+    return &x->slot[x->back];
+}
+
+/* Control thread: make the back slot the newest snapshot */
+static void jc_params_publish(jc_params_xchg_t *x) {
+    unsigned prev = atomic_exchange_explicit(&x->middle, x->back | JC_PARAMS_DIRTY,
+                                             memory_order_acq_rel);
+    x->back = prev & 3u;
+}
+
+/* Audio thread: latest snapshot, or NULL if nothing new was published */
+static const jc_params_t *jc_params_acquire(jc_params_xchg_t *x) {
+    if (!(atomic_load_explicit(&x->middle, memory_order_relaxed) & JC_PARAMS_DIRTY))
+        return NULL;
+    unsigned prev = atomic_exchange_explicit(&x->middle, x->front, memory_order_acq_rel);
+    x->front = prev & 3u;
+    return &x->slot[x->front];
+}
+
+/* Instance structure */
+typedef struct jc_instance {
+    char module_dir[256];
+
+    /* Rate-derived constants, fixed at create */
+    float sample_rate;
+    int   smooth_frames;
+    const jc_kernel_t *kernel;
+    const jc_core_row_t *core_row[2];   /* kernel's tap stages at full, half rate */
+
+    /* Engine and interpolation the audio thread is running */
+    int   model_on;
+    int   quality_on;
+    int   engine_on;
+
+    /* Delay ring rate: sample_rate, or half of it with half_rate on */
+    int   half_rate_on;
+    float dt_min;       /* shortest tap, ring samples */
+    float dt_rng;       /* tap sweep range, ring samples */
+    int32_t q_dt_min;   /* the same in 16.16 for the fixed-point engine */
+    int32_t q_dt_rng;
+
+    /* Parameters (control thread) */
+    int   mode;         /* 0=I, 1=I+II, 2=II */
+    float mix;          /* 0-1 dry/wet */
+    float brightness;   /* 0-1 filter brightness */
+    int   half_rate;    /* 0/1 half-rate wet path */
+    int   model;        /* JC_MODEL_* */
+    int   quality;      /* JC_INTERP_* */
+    int   engine;       /* JC_ENGINE_* */
+
+    /* Derived coefficients: published by control, picked up per block */
+    jc_params_xchg_t params;
+    jc_params_t      cur;       /* audio thread's copy (ramp targets) */
+
+    /*
+     * Smoothed values the stages actually use. A stage only fills and
+     * reads per-frame ramp arrays while one of its ramps is moving.
+     */
+    jc_ramp_t gain_a;
+    jc_ramp_t gain_b;
+    jc_ramp_t dry_g;
+    jc_ramp_t wet_g;
+    jc_ramp_t pre_alpha;
+    jc_ramp_t post_alpha;
+    int       primed;   /* a block has run; until then changes snap */
+
+    /* Idle tracking (audio thread) */
+    int run_state;              /* JC_RUN_* */
+    int quiet_frames;           /* silent input frames since the last signal */
+
+    /* Chunks whose state went NaN/Inf and was reset; read by get_param */
+    atomic_uint nonfinite_resets;
+
+    /* DSP state (audio thread) */
+    delay_line_t delay;
+    lfo_t        lfo1;
+    lfo_t        lfo2;
+    fo_lpf_t     pre_lpf;
+    fo_lpf_t     post_lpf_l;
+    fo_lpf_t     post_lpf_r;
+    hb_decim_t   hb_down;
+    hb_interp_t  hb_up_l;
+    hb_interp_t  hb_up_r;
+    float        ap_y[4];       /* Thiran tap state: LFO1 L/R, LFO2 L/R */
+    bbd_line_t   bbd[4];        /* LFO1 L/R, LFO2 L/R */
+    bbd_input_t  bbd_in;        /* shared input filter bank */
+    bbd_filter_t bbd_filter;    /* filter bank constants at sample_rate */
+    int32_t      q_pre;         /* fixed-point filter state, Q30 */
+    int32_t      q_post_l;
+    int32_t      q_post_r;
+
+    /* Block pipeline scratch, one chunk per stage */
+    float in_l[JC_CHUNK]  JC_ALIGNED;
+    float in_r[JC_CHUNK]  JC_ALIGNED;
+    float mono[JC_CHUNK]  JC_ALIGNED;
+    float wet_l[JC_CHUNK] JC_ALIGNED;
+    float wet_r[JC_CHUNK] JC_ALIGNED;
+    float lfo1_v[JC_CHUNK] JC_ALIGNED;
+    float lfo2_v[JC_CHUNK] JC_ALIGNED;
+    float ramp_a[JC_CHUNK] JC_ALIGNED;
+    float ramp_b[JC_CHUNK] JC_ALIGNED;
+    float half[JC_CHUNK / 2 + 1]   JC_ALIGNED;
+    /* Fixed-point engine scratch */
+    int16_t  q_in_l[JC_CHUNK]  JC_ALIGNED;
+    int16_t  q_in_r[JC_CHUNK]  JC_ALIGNED;
+    int16_t  q_mono[JC_CHUNK]  JC_ALIGNED;
+    int32_t  q_wet_l[JC_CHUNK] JC_ALIGNED;
+    int32_t  q_wet_r[JC_CHUNK] JC_ALIGNED;
+    int32_t  q_ramp_a[JC_CHUNK] JC_ALIGNED;
+    int32_t  q_ramp_b[JC_CHUNK] JC_ALIGNED;
+} jc_instance_t;
+
+/* --- Block pipeline stages --- */
+
+/*
+ * Each stage runs over the whole chunk before the next one starts, so
+ * the loops are independent and can be vectorized (and profiled) one
+ * at a time:
+ *
+ *   input -> premix -> ring write -> taps -> post-filter -> output
+ */
+
+/* Pre-filter in place, at the ring rate */
+static void jc_stage_prefilter(jc_instance_t *inst, float *x, int n) {
+    fo_lpf_t *f = &inst->pre_lpf;
+    if (inst->pre_alpha.left) {
+        jc_ramp_fill(&inst->pre_alpha, inst->ramp_a, n);
+        for (int i = 0; i < n; i++) {
+            f->state += inst->ramp_a[i] * (x[i] - f->state);
+            x[i] = f->state;
+        }
+        f->alpha = inst->pre_alpha.value;
         return;
     }
-    float w = 2.0f * (float)M_PI * hz / SAMPLE_RATE;
-    f->alpha = w / (1.0f + w);
+    fo_lpf_block(f, x, n);
 }
 
-static inline float fo_lpf_process(fo_lpf_t *f, float x) {
-    f->state += f->alpha * (x - f->state);
-    return f->state;
+/*
+ * Mono sum -> soft-limit -> pre-filter. On the half-rate path the
+ * pre-filter runs after the decimator instead.
+ * The Juno-60 sums to mono before the BBD (no compander).
+ */
+static void jc_stage_premix(jc_instance_t *inst, int n) {
+    for (int i = 0; i < n; i++)
+        inst->mono[i] = soft_limit((inst->in_l[i] + inst->in_r[i]) * 0.5f);
+    if (!inst->half_rate_on)
+        jc_stage_prefilter(inst, inst->mono, n);
 }
 
-/* --- Delay line with fractional read --- */
+/* Fill the active LFO ramps; a silent LFO only advances its phase */
+static inline __attribute__((always_inline))
+void jc_stage_lfos(jc_instance_t *inst, int n, const int use_a, const int use_b) {
+    if (use_a) lfo_fill(&inst->lfo1, inst->lfo1_v, n);
+    else       lfo_advance(&inst->lfo1, n);
+    if (use_b) lfo_fill(&inst->lfo2, inst->lfo2_v, n);
+    else       lfo_advance(&inst->lfo2, n);
+}
 
-typedef struct {
-    float buf[DELAY_BUF_SIZE];
-    int write_pos;
-} delay_line_t;
+/*
+ * BBD engine counterpart of the core's tap stages (jc_core.hpp): one
+ * clocked line per tap, fed from the pre-filtered mono through the
+ * shared input bank instead of a ring. use_a/use_b/ramp are
+ * compile-time constants, as there. The line clocks are set for the
+ * whole chunk up front.
+ */
+static inline __attribute__((always_inline))
+void jc_stage_bbd_tmpl(jc_instance_t *inst, int n,
+                       const int use_a, const int use_b, const int ramp) {
+    const float ga = inst->gain_a.value;
+    const float gb = inst->gain_b.value;
+    const float dt_min = inst->dt_min;
+    const float dt_rng = inst->dt_rng;
+    const bbd_filter_t *f = &inst->bbd_filter;
+    bbd_input_t *in = &inst->bbd_in;
+    float ticks[4][JC_CHUNK] JC_ALIGNED;
+    float span[4][JC_CHUNK]  JC_ALIGNED;
+
+    jc_stage_lfos(inst, n, use_a, use_b);
+
+    /* L follows the LFO, R its inverse: dt_min + dt_rng * (1 - v) */
+    if (use_a) {
+        bbd_clock_block(inst->lfo1_v, dt_min, dt_rng, ticks[0], span[0], n);
+        bbd_clock_block(inst->lfo1_v, dt_min + dt_rng, -dt_rng, ticks[1], span[1], n);
+    }
+    if (use_b) {
+        bbd_clock_block(inst->lfo2_v, dt_min, dt_rng, ticks[2], span[2], n);
+        bbd_clock_block(inst->lfo2_v, dt_min + dt_rng, -dt_rng, ticks[3], span[3], n);
+    }
+
+    for (int i = 0; i < n; i++) {
+        float wet_l = 0.0f;
+        float wet_r = 0.0f;
 
-static void delay_init(delay_line_t *d) {
-    memset(d->buf, 0, sizeof(d->buf));
-    d->write_pos = 0;
+        if (use_a) {
+            float ga_i = ramp ? inst->ramp_a[i] : ga;
+            wet_l += ga_i * bbd_process(&inst->bbd[0], f, in, ticks[0][i], span[0][i]);
+            wet_r += ga_i * bbd_process(&inst->bbd[1], f, in, ticks[1][i], span[1][i]);
+        }
+        if (use_b) {
+            float gb_i = ramp ? inst->ramp_b[i] : gb;
+            wet_l += gb_i * bbd_process(&inst->bbd[2], f, in, ticks[2][i], span[2][i]);
+            wet_r += gb_i * bbd_process(&inst->bbd[3], f, in, ticks[3][i], span[3][i]);
+        }
+
+        inst->wet_l[i] = wet_l;
+        inst->wet_r[i] = wet_r;
+        bbd_input_push(f, in, inst->mono[i]);
+    }
 }
 
-static inline void delay_write(delay_line_t *d, float x) {
-    d->buf[d->write_pos] = x;
-    d->write_pos = (d->write_pos + 1) & DELAY_BUF_MASK;
+static void jc_stage_bbd_i(jc_instance_t *inst, int n) {
+    jc_stage_bbd_tmpl(inst, n, 1, 0, 0);
 }
 
-static inline float delay_read_frac(delay_line_t *d, float delay_samples) {
-    int di = (int)delay_samples;
-    float frac = delay_samples - (float)di;
-    int p0 = (d->write_pos - 1 - di) & DELAY_BUF_MASK;
-    int p1 = (p0 - 1) & DELAY_BUF_MASK;
-    return d->buf[p0] * (1.0f - frac) + d->buf[p1] * frac;
+static void jc_stage_bbd_i_ii(jc_instance_t *inst, int n) {
+    jc_stage_bbd_tmpl(inst, n, 1, 1, 0);
 }
 
-/* --- Triangle LFO (unipolar 0..1) --- */
+static void jc_stage_bbd_ii(jc_instance_t *inst, int n) {
+    jc_stage_bbd_tmpl(inst, n, 0, 1, 0);
+}
 
-typedef struct {
-    float phase, phase_inc;
-} lfo_t;
+static void jc_stage_bbd_ramp(jc_instance_t *inst, int n) {
+    jc_ramp_fill(&inst->gain_a, inst->ramp_a, n);
+    jc_ramp_fill(&inst->gain_b, inst->ramp_b, n);
+    jc_stage_bbd_tmpl(inst, n, 1, 1, 1);
+}
 
-static void lfo_init(lfo_t *l, float rate_hz) {
-    l->phase = 0.0f;
-    l->phase_inc = rate_hz / SAMPLE_RATE;
+/* The instance state the core's tap stages work on */
+static jc_core_taps_t jc_core_state(jc_instance_t *inst) {
+    jc_core_taps_t t = {
+        &inst->lfo1, &inst->lfo2, &inst->gain_a, &inst->gain_b, inst->ap_y,
+        inst->wet_l, inst->wet_r, inst->q_wet_l, inst->q_wet_r,
+        inst->dt_min, inst->dt_rng, inst->q_dt_min, inst->q_dt_rng
+    };
+    return t;
 }
 
-static inline float lfo_tick(lfo_t *l) {
-    l->phase += l->phase_inc;
-    if (l->phase >= 1.0f) l->phase -= 1.0f;
-    float t = l->phase * 2.0f;
-    return (t > 1.0f) ? (2.0f - t) : t;
+/*
+ * Taps for the running model: the core's for the ideal one, reading
+ * the ring from index pos (frame 0), or the BBD lines (pos unused)
+ */
+static void jc_stage_taps(jc_instance_t *inst, int pos, int n) {
+    const int ramp = inst->gain_a.left || inst->gain_b.left;
+
+    if (inst->model_on == JC_MODEL_BBD) {
+        (ramp ? inst->cur.bbd_stage_ramp : inst->cur.bbd_stage)(inst, n);
+        return;
+    }
+    jc_core_taps_t t = jc_core_state(inst);
+    (ramp ? inst->cur.tap_stage_ramp : inst->cur.tap_stage)
+        (&t, delay_block_base(&inst->delay, pos), n);
 }
 
-/* ================================================================
- * Audio FX API v2 - Instance-based
- * ================================================================ */
+static void jc_stage_post(jc_instance_t *inst, int n) {
+    fo_lpf_t *fl = &inst->post_lpf_l;
+    fo_lpf_t *fr = &inst->post_lpf_r;
+
+    if (inst->post_alpha.left) {
+        jc_ramp_fill(&inst->post_alpha, inst->ramp_a, n);
+        for (int i = 0; i < n; i++) {
+            fl->state += inst->ramp_a[i] * (inst->wet_l[i] - fl->state);
+            fr->state += inst->ramp_a[i] * (inst->wet_r[i] - fr->state);
+            inst->wet_l[i] = fl->state;
+            inst->wet_r[i] = fr->state;
+        }
+        fl->alpha = fr->alpha = inst->post_alpha.value;
+        return;
+    }
+    fo_lpf_block_stereo(fl, fr, inst->wet_l, inst->wet_r, n);
+}
 
-static const host_api_v1_t *g_host = NULL;
+/* Mix dry and wet into wet_l/wet_r (clamped on conversion) */
+static void jc_stage_mix(jc_instance_t *inst, int n) {
+    if (inst->dry_g.left || inst->wet_g.left) {
+        jc_ramp_fill(&inst->dry_g, inst->ramp_a, n);
+        jc_ramp_fill(&inst->wet_g, inst->ramp_b, n);
+        for (int i = 0; i < n; i++) {
+            inst->wet_l[i] = inst->in_l[i] * inst->ramp_a[i] + inst->wet_l[i] * inst->ramp_b[i];
+            inst->wet_r[i] = inst->in_r[i] * inst->ramp_a[i] + inst->wet_r[i] * inst->ramp_b[i];
+        }
+        return;
+    }
 
-#define AUDIO_FX_API_VERSION_2 2
+    const float dry_g = inst->dry_g.value;
+    const float wet_g = inst->wet_g.value;
 
-typedef struct audio_fx_api_v2 {
-    uint32_t api_version;
-    void *(*create_instance)(const char *module_dir, const char *config_json);
-    void (*destroy_instance)(void *instance);
-    void (*process_block)(void *instance, int16_t *audio_inout, int frames);
-    void (*set_param)(void *instance, const char *key, const char *val);
-    int  (*get_param)(void *instance, const char *key, char *buf, int buf_len);
-} audio_fx_api_v2_t;
+    /* Full wet: the output is the wet signal as it stands */
+    if (dry_g == 0.0f && wet_g == 1.0f) return;
 
-typedef audio_fx_api_v2_t *(*audio_fx_init_v2_fn)(const host_api_v1_t *host);
+    for (int i = 0; i < n; i++) {
+        inst->wet_l[i] = inst->in_l[i] * dry_g + inst->wet_l[i] * wet_g;
+        inst->wet_r[i] = inst->in_r[i] * dry_g + inst->wet_r[i] * wet_g;
+    }
+}
 
-/* LPF cutoff ranges in Hz - clamped below Nyquist */
-#define PRE_LPF_MIN   2000.0f
-#define PRE_LPF_MAX   20000.0f
-#define POST_LPF_MIN  6000.0f
-#define POST_LPF_MAX  20000.0f
+/* --- Fixed-point (Q15) stages --- */
 
-/* Instance structure */
-typedef struct {
-    char module_dir[256];
+/*
+ * int16 in and out with no float conversion, on jc_simd.h vectors
+ * throughout: vld2/vhadd for the premix, vqdmulh for the soft limiter,
+ * the block-form filters, the tap gains and the mix, gathered taps
+ * interpolated with vqrdmulh, and vqadd/vqrshrn into the output. Ring
+ * samples are Q15 and everything between stages Q30 (see the
+ * fixed-point primitives in jc_dsp.h); the taps are the core's Q15
+ * stages. Covers the ideal model with linear taps at full rate;
+ * jc_update_params falls back to float for anything else.
+ */
 
-    /* Parameters */
-    int   mode;         /* 0=I, 1=I+II, 2=II */
-    float mix;          /* 0-1 dry/wet */
-    float brightness;   /* 0-1 filter brightness */
+/* Deinterleave, mono sum -> soft-limit -> pre-filter -> Q15 ring samples */
+static void jc_stage_premix_q15(jc_instance_t *inst, const int16_t *io, int n) {
+    int32_t x[JC_CHUNK] JC_ALIGNED;
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        jc_v8s l, r;
+        jc_v8s_load2(io + i * 2, &l, &r);
+        jc_v8s_store(inst->q_in_l + i, l);
+        jc_v8s_store(inst->q_in_r + i, r);
+        jc_v8s m = jc_v8s_hadd(l, r);
+        jc_v4i_store(x + i, soft_limit_q30_v4(jc_v8s_lo(m)));
+        jc_v4i_store(x + i + 4, soft_limit_q30_v4(jc_v8s_hi(m)));
+    }
+    for (; i < n; i++) {
+        inst->q_in_l[i] = io[i * 2];
+        inst->q_in_r[i] = io[i * 2 + 1];
+        x[i] = soft_limit_q30((io[i * 2] + io[i * 2 + 1]) >> 1);
+    }
 
-    /* Derived gains */
-    float gain_a;       /* LFO1 tap gain */
-    float gain_b;       /* LFO2 tap gain */
+    if (inst->pre_alpha.left) {
+        jc_ramp_fill_q31(&inst->pre_alpha, inst->q_ramp_a, n);
+        for (i = 0; i < n; i++)
+            x[i] = fo_lpf_process_q(&inst->q_pre, inst->q_ramp_a[i], x[i]);
+        inst->pre_lpf.alpha = inst->pre_alpha.value;
+    } else {
+        fo_lpf_q_t c;
+        fo_lpf_q_init(&c, inst->pre_alpha.value);
+        fo_lpf_block_q(&inst->q_pre, &c, x, n);
+    }
 
-    /* DSP state */
-    delay_line_t delay;
-    lfo_t        lfo1;
-    lfo_t        lfo2;
-    fo_lpf_t     pre_lpf;
-    fo_lpf_t     post_lpf_l;
-    fo_lpf_t     post_lpf_r;
-} jc_instance_t;
+    for (i = 0; i + 8 <= n; i += 8)
+        jc_v8s_store(inst->q_mono + i, jc_v8s_qrshrn15(jc_v4i_load(x + i), jc_v4i_load(x + i + 4)));
+    for (; i < n; i++)
+        inst->q_mono[i] = jc_qrshrn15_s32(x[i]);
+}
+
+static void jc_stage_post_q15(jc_instance_t *inst, int n) {
+    if (inst->post_alpha.left) {
+        jc_ramp_fill_q31(&inst->post_alpha, inst->q_ramp_a, n);
+        for (int i = 0; i < n; i++) {
+            int32_t a = inst->q_ramp_a[i];
+            inst->q_wet_l[i] = fo_lpf_process_q(&inst->q_post_l, a, inst->q_wet_l[i]);
+            inst->q_wet_r[i] = fo_lpf_process_q(&inst->q_post_r, a, inst->q_wet_r[i]);
+        }
+        inst->post_lpf_l.alpha = inst->post_lpf_r.alpha = inst->post_alpha.value;
+        return;
+    }
+
+    fo_lpf_q_t c;
+    fo_lpf_q_init(&c, inst->post_alpha.value);
+    fo_lpf_block_q(&inst->q_post_l, &c, inst->q_wet_l, n);
+    fo_lpf_block_q(&inst->q_post_r, &c, inst->q_wet_r, n);
+}
+
+/* dry_g * in + wet_g * wet, Q15 and Q30 in, to Q30 saturated */
+static inline int32_t jc_mix_q30(int32_t in, int32_t wet, int32_t dry_g, int32_t wet_g) {
+    return jc_qadd_s32(jc_qdmulh_s32(in * (1 << JC_Q_SHIFT), dry_g), jc_qdmulh_s32(wet, wet_g));
+}
+
+static inline jc_v4i jc_mix_q30_v4(jc_v4i in, jc_v4i wet, jc_v4i dry_g, jc_v4i wet_g) {
+    return jc_v4i_qadd(jc_v4i_qdmulh(in * (1 << JC_Q_SHIFT), dry_g), jc_v4i_qdmulh(wet, wet_g));
+}
+
+/* Mix into io, eight frames per vector; gains per frame while ramping */
+static void jc_stage_mix_q15(jc_instance_t *inst, int16_t *io, int n) {
+    const int32_t *wl = inst->q_wet_l;
+    const int32_t *wr = inst->q_wet_r;
+    int i = 0;
+
+    /* Full wet: the wet signal, rounded and saturated */
+    if (!inst->dry_g.left && !inst->wet_g.left &&
+        inst->dry_g.value == 0.0f && inst->wet_g.value == 1.0f) {
+        for (; i + 8 <= n; i += 8)
+            jc_v8s_store2(io + i * 2,
+                          jc_v8s_qrshrn15(jc_v4i_load(wl + i), jc_v4i_load(wl + i + 4)),
+                          jc_v8s_qrshrn15(jc_v4i_load(wr + i), jc_v4i_load(wr + i + 4)));
+        for (; i < n; i++) {
+            io[i * 2]     = jc_qrshrn15_s32(wl[i]);
+            io[i * 2 + 1] = jc_qrshrn15_s32(wr[i]);
+        }
+        return;
+    }
+
+    const int ramp = inst->dry_g.left || inst->wet_g.left;
+    const int32_t *dg = inst->q_ramp_a;
+    const int32_t *wg = inst->q_ramp_b;
+    const int32_t d = jc_q31(inst->dry_g.value);
+    const int32_t w = jc_q31(inst->wet_g.value);
+    if (ramp) {
+        jc_ramp_fill_q31(&inst->dry_g, inst->q_ramp_a, n);
+        jc_ramp_fill_q31(&inst->wet_g, inst->q_ramp_b, n);
+    }
+
+    for (; i + 8 <= n; i += 8) {
+        jc_v4i d0 = ramp ? jc_v4i_load(dg + i)     : jc_v4i_set1(d);
+        jc_v4i d1 = ramp ? jc_v4i_load(dg + i + 4) : jc_v4i_set1(d);
+        jc_v4i w0 = ramp ? jc_v4i_load(wg + i)     : jc_v4i_set1(w);
+        jc_v4i w1 = ramp ? jc_v4i_load(wg + i + 4) : jc_v4i_set1(w);
+        jc_v8s il = jc_v8s_load(inst->q_in_l + i);
+        jc_v8s ir = jc_v8s_load(inst->q_in_r + i);
+        jc_v4i l0 = jc_mix_q30_v4(jc_v8s_lo(il), jc_v4i_load(wl + i), d0, w0);
+        jc_v4i l1 = jc_mix_q30_v4(jc_v8s_hi(il), jc_v4i_load(wl + i + 4), d1, w1);
+        jc_v4i r0 = jc_mix_q30_v4(jc_v8s_lo(ir), jc_v4i_load(wr + i), d0, w0);
+        jc_v4i r1 = jc_mix_q30_v4(jc_v8s_hi(ir), jc_v4i_load(wr + i + 4), d1, w1);
+        jc_v8s out_l = jc_v8s_qrshrn15(l0, l1);
+        jc_v8s out_r = jc_v8s_qrshrn15(r0, r1);
+        jc_v8s_store2(io + i * 2, out_l, out_r);
+    }
+    for (; i < n; i++) {
+        int32_t d_i = ramp ? dg[i] : d;
+        int32_t w_i = ramp ? wg[i] : w;
+        io[i * 2]     = jc_qrshrn15_s32(jc_mix_q30(inst->q_in_l[i], wl[i], d_i, w_i));
+        io[i * 2 + 1] = jc_qrshrn15_s32(jc_mix_q30(inst->q_in_r[i], wr[i], d_i, w_i));
+    }
+}
 
 static void jc_log(const char *msg) {
     if (g_host && g_host->log) {
@@ -211,34 +645,231 @@ static void jc_log(const char *msg) {
     }
 }
 
+/* Wet path runs at half the sample rate (BBD has no ring, so never) */
+static int jc_half_rate(const jc_instance_t *inst) {
+    return inst->half_rate && inst->model == JC_MODEL_IDEAL;
+}
+
+/*
+ * Pre/post filter coefficients from brightness (quadratic curve), at
+ * the ring rate the filters run at
+ */
+static void jc_filter_alphas(const jc_instance_t *inst, float *pre_alpha, float *post_alpha) {
+    float br = inst->brightness * inst->brightness;
+    float pre_hz  = PRE_LPF_MIN  + br * (PRE_LPF_MAX  - PRE_LPF_MIN);
+    float post_hz = POST_LPF_MIN + br * (POST_LPF_MAX - POST_LPF_MIN);
+    float rate = jc_half_rate(inst) ? inst->sample_rate * 0.5f : inst->sample_rate;
+
+    *pre_alpha  = fo_lpf_alpha(pre_hz,  rate);
+    *post_alpha = fo_lpf_alpha(post_hz, rate);
+}
+
+/* Frames for a one-pole lowpass to decay from full scale to JC_SILENCE */
+static int fo_lpf_decay_frames(float alpha) {
+    if (alpha >= 1.0f) return 0;
+    return (int)ceilf(logf(JC_SILENCE) / logf(1.0f - alpha));
+}
+
+/*
+ * Frames of silent input until the wet path has drained below
+ * JC_SILENCE: pre-filter decay, the longest tap, resampler, allpass
+ * or BBD filter history, then post-filter decay.
+ */
+static int jc_tail_frames(const jc_instance_t *inst, float pre_alpha, float post_alpha) {
+    int tail = fo_lpf_decay_frames(pre_alpha) + fo_lpf_decay_frames(post_alpha);
+
+    if (jc_half_rate(inst))             /* filters count half-rate ticks */
+        tail *= 2;
+    tail += (int)(DELAY_MAX_SEC * inst->sample_rate) + 3;
+    if (inst->model == JC_MODEL_BBD)        /* held bucket, filter banks */
+        tail += 2 + bbd_filter_decay_frames(&inst->bbd_filter, JC_SILENCE);
+    else if (inst->half_rate)
+        tail += 2 * HB_ORDER;           /* decimator + interpolator */
+    if (inst->model == JC_MODEL_IDEAL && inst->quality == JC_INTERP_THIRAN)
+        tail += 13;                     /* |eta| <= 1/3 */
+    return tail;
+}
+
+/* Control thread: derive coefficients and publish them to the audio thread */
 static void jc_update_params(jc_instance_t *inst) {
+    jc_params_t *p = jc_params_back(&inst->params);
+
     /* Mode gains */
     int m = inst->mode;
     if (m < 0) m = 0;
     if (m > 2) m = 2;
-    inst->gain_a = MODE_GAIN[m][0];
-    inst->gain_b = MODE_GAIN[m][1];
+    p->gain_a = MODE_GAIN[m][0];
+    p->gain_b = MODE_GAIN[m][1];
+
+    /* Delay engine; the core's stages come from the row for the ring rate */
+    const jc_core_row_t *row = inst->core_row[jc_half_rate(inst)];
+    p->model              = inst->model;
+    p->quality            = inst->quality;
+    p->tap_stage          = row->taps[inst->quality][m];
+    p->tap_stage_ramp     = row->taps[inst->quality][JC_TAP_RAMP];
+    p->tap_stage_q15      = row->taps_q15[m];
+    p->tap_stage_q15_ramp = row->taps_q15[JC_TAP_RAMP];
+    p->bbd_stage          = inst->kernel->taps_bbd[m];
+    p->bbd_stage_ramp     = inst->kernel->taps_bbd[JC_TAP_RAMP];
+
+    /*
+     * The fixed-point engine only implements ideal/linear/full rate. Its
+     * Q15 ring is allocated here, the first time it is picked, and
+     * published with the snapshot; float-only instances never have one.
+     */
+    p->engine = (inst->engine == JC_ENGINE_FIXED && inst->model == JC_MODEL_IDEAL &&
+                 inst->quality == JC_INTERP_LINEAR && !inst->half_rate)
+        ? JC_ENGINE_FIXED : JC_ENGINE_FLOAT;
+    if (p->engine == JC_ENGINE_FIXED && delay_init_q15(&inst->delay) != 0) {
+        jc_log("Failed to allocate fixed-point delay line; using float");
+        p->engine = JC_ENGINE_FLOAT;
+    }
 
-    /* Filter cutoffs from brightness (quadratic curve) */
-    float br = inst->brightness * inst->brightness;
-    float pre_hz  = PRE_LPF_MIN  + br * (PRE_LPF_MAX  - PRE_LPF_MIN);
-    float post_hz = POST_LPF_MIN + br * (POST_LPF_MAX - POST_LPF_MIN);
+    /*
+     * Equal-power crossfade for dry/wet. The endpoints are exact so
+     * the bypass and full-wet fast paths can recognize them.
+     */
+    p->dry_g = inst->mix <= 0.0f ? 1.0f : fast_sqrt(1.0f - inst->mix);
+    p->wet_g = inst->mix >= 1.0f ? 1.0f : fast_sqrt(inst->mix);
+
+    jc_filter_alphas(inst, &p->pre_alpha, &p->post_alpha);
+
+    p->half_rate = inst->half_rate;
+    p->tail_frames = jc_tail_frames(inst, p->pre_alpha, p->post_alpha);
+
+    jc_params_publish(&inst->params);
+}
+
+/* Audio thread: zero the delay ring of the running engine */
+static void jc_clear_ring(jc_instance_t *inst) {
+    if (inst->engine_on == JC_ENGINE_FIXED)
+        delay_clear_q15(&inst->delay);
+    else
+        delay_clear(&inst->delay);
+}
+
+/*
+ * Audio thread: switch the ring and taps between full and half rate.
+ * Rate-dependent tap state is rebuilt and the ring and resampler
+ * history cleared; LFO phase carries over. The filter coefficients
+ * are snapped, since ramping between the two rates' values is not a
+ * brightness change.
+ */
+static void jc_set_ring_rate(jc_instance_t *inst, int half) {
+    float ring_rate = half ? inst->sample_rate * 0.5f : inst->sample_rate;
+    uint32_t sr = (uint32_t)lrintf(inst->sample_rate);
+    uint32_t decim = half ? 2 : 1;
+
+    inst->half_rate_on    = half;
+    inst->dt_min          = DELAY_MIN_SEC * ring_rate;
+    inst->dt_rng          = (DELAY_MAX_SEC - DELAY_MIN_SEC) * ring_rate;
+    inst->q_dt_min        = (int32_t)lrintf(inst->dt_min * 65536.0f);
+    inst->q_dt_rng        = (int32_t)lrintf(inst->dt_rng * 65536.0f);
+    lfo_set_rate(&inst->lfo1, LFO_RATE_MHZ[0], sr, decim);
+    lfo_set_rate(&inst->lfo2, LFO_RATE_MHZ[1], sr, decim);
+
+    jc_clear_ring(inst);
+    memset(inst->ap_y, 0, sizeof(inst->ap_y));
+    memset(&inst->hb_down, 0, sizeof(inst->hb_down));
+    memset(&inst->hb_up_l, 0, sizeof(inst->hb_up_l));
+    memset(&inst->hb_up_r, 0, sizeof(inst->hb_up_r));
+
+    jc_ramp_reset(&inst->pre_alpha,  inst->cur.pre_alpha);
+    jc_ramp_reset(&inst->post_alpha, inst->cur.post_alpha);
+    inst->pre_lpf.alpha    = inst->cur.pre_alpha;
+    inst->post_lpf_l.alpha = inst->cur.post_alpha;
+    inst->post_lpf_r.alpha = inst->cur.post_alpha;
+}
+
+/* Audio thread: switch delay engine, starting the new one from silence */
+static void jc_set_model(jc_instance_t *inst, int model) {
+    inst->model_on = model;
+    memset(inst->bbd, 0, sizeof(inst->bbd));
+    memset(&inst->bbd_in, 0, sizeof(inst->bbd_in));
+    memset(inst->ap_y, 0, sizeof(inst->ap_y));
+    jc_clear_ring(inst);
+}
+
+/* Audio thread: settle every smoothed value on the current snapshot */
+static void jc_snap_params(jc_instance_t *inst) {
+    jc_ramp_reset(&inst->gain_a,     inst->cur.gain_a);
+    jc_ramp_reset(&inst->gain_b,     inst->cur.gain_b);
+    jc_ramp_reset(&inst->dry_g,      inst->cur.dry_g);
+    jc_ramp_reset(&inst->wet_g,      inst->cur.wet_g);
+    jc_ramp_reset(&inst->pre_alpha,  inst->cur.pre_alpha);
+    jc_ramp_reset(&inst->post_alpha, inst->cur.post_alpha);
+    inst->pre_lpf.alpha    = inst->cur.pre_alpha;
+    inst->post_lpf_l.alpha = inst->cur.post_alpha;
+    inst->post_lpf_r.alpha = inst->cur.post_alpha;
+}
+
+/* Audio thread: take the newest snapshot and retarget the ramps */
+static void jc_pull_params(jc_instance_t *inst) {
+    const jc_params_t *p = jc_params_acquire(&inst->params);
+    if (!p) return;
+
+    inst->cur = *p;
+
+    /* The BBD engine has no ring, so it always runs at full rate */
+    int half = p->half_rate && p->model == JC_MODEL_IDEAL;
+    if (p->model != inst->model_on)
+        jc_set_model(inst, p->model);
+    if (half != inst->half_rate_on)
+        jc_set_ring_rate(inst, half);
+
+    /* Allpass state from another tier is meaningless; restart it */
+    if (p->quality != inst->quality_on) {
+        inst->quality_on = p->quality;
+        memset(inst->ap_y, 0, sizeof(inst->ap_y));
+    }
 
-    fo_lpf_set_cutoff(&inst->pre_lpf,    pre_hz);
-    fo_lpf_set_cutoff(&inst->post_lpf_l, post_hz);
-    fo_lpf_set_cutoff(&inst->post_lpf_r, post_hz);
+    /*
+     * Nothing has been rendered yet (set_param between create and the
+     * first block, e.g. a patch restore): start on the values rather
+     * than ramping in from the defaults
+     */
+    if (!inst->primed) {
+        jc_snap_params(inst);
+        return;
+    }
+
+    const int f = inst->smooth_frames;
+    jc_ramp_set(&inst->gain_a,     p->gain_a,     f);
+    jc_ramp_set(&inst->gain_b,     p->gain_b,     f);
+    jc_ramp_set(&inst->dry_g,      p->dry_g,      f);
+    jc_ramp_set(&inst->wet_g,      p->wet_g,      f);
+    jc_ramp_set(&inst->pre_alpha,  p->pre_alpha,  f);
+    jc_ramp_set(&inst->post_alpha, p->post_alpha, f);
 }
 
 /* --- API callbacks --- */
 
+/* Best process kernel for this CPU, picked by jc_select_kernel at init */
+static const jc_kernel_t *g_kernel = NULL;
+
+/*
+ * Run inst on kernel k, with the core's tap stages specialized for its
+ * full and half ring rates where the core has them. The stages are
+ * taken from these rows by jc_update_params.
+ */
+static void jc_bind_kernel(jc_instance_t *inst, const jc_kernel_t *k) {
+    inst->kernel      = k;
+    inst->core_row[0] = jc_core_bind(k->core, inst->sample_rate);
+    inst->core_row[1] = jc_core_bind(k->core, inst->sample_rate * 0.5f);
+}
+
 static void *v2_create_instance(const char *module_dir, const char *config_json) {
     jc_log("Creating instance");
 
-    jc_instance_t *inst = (jc_instance_t *)calloc(1, sizeof(jc_instance_t));
-    if (!inst) {
+    /* Aligned so the scratch arrays start on cache lines */
+    void *mem = NULL;
+    if (posix_memalign(&mem, JC_CACHE_LINE, sizeof(jc_instance_t)) != 0) {
         jc_log("Failed to allocate instance");
         return NULL;
     }
+    jc_instance_t *inst = (jc_instance_t *)mem;
+    memset(inst, 0, sizeof(*inst));
+    atomic_init(&inst->nonfinite_resets, 0u);
 
     if (module_dir)
         strncpy(inst->module_dir, module_dir, sizeof(inst->module_dir) - 1);
@@ -248,15 +879,34 @@ static void *v2_create_instance(const char *module_dir, const char *config_json)
     inst->mix        = 0.5f;
     inst->brightness = 1.0f;  /* Full brightness (no filtering) */
 
-    /* Init DSP */
-    delay_init(&inst->delay);
-    lfo_init(&inst->lfo1, LFO_RATE[0]);
-    lfo_init(&inst->lfo2, LFO_RATE[1]);
+    /* Rate-derived constants from the host rate */
+    float sr = (g_host && g_host->sample_rate > 0) ? (float)g_host->sample_rate
+                                                  : DEFAULT_SAMPLE_RATE;
+    inst->sample_rate   = sr;
+    inst->dt_min        = DELAY_MIN_SEC * sr;                    /* ~73.2 @ 44.1k */
+    inst->dt_rng        = (DELAY_MAX_SEC - DELAY_MIN_SEC) * sr;  /* ~162.7 @ 44.1k */
+    inst->q_dt_min      = (int32_t)lrintf(inst->dt_min * 65536.0f);
+    inst->q_dt_rng      = (int32_t)lrintf(inst->dt_rng * 65536.0f);
+    inst->smooth_frames = (int)(SMOOTH_SEC * sr) + 1;
+    jc_bind_kernel(inst, g_kernel);
+
+    /* Init DSP; the ring covers the longest tap plus interpolation */
+    if (delay_init(&inst->delay, (int)(inst->dt_min + inst->dt_rng) + 3) != 0) {
+        jc_log("Failed to allocate delay line");
+        free(inst);
+        return NULL;
+    }
+    lfo_init(&inst->lfo1, LFO_RATE_MHZ[0], (uint32_t)lrintf(sr));
+    lfo_init(&inst->lfo2, LFO_RATE_MHZ[1], (uint32_t)lrintf(sr));
     fo_lpf_init(&inst->pre_lpf);
     fo_lpf_init(&inst->post_lpf_l);
     fo_lpf_init(&inst->post_lpf_r);
+    bbd_filter_init(&inst->bbd_filter, sr);
 
+    jc_params_xchg_init(&inst->params);
+    /* Not primed yet, so this starts the ramps on the defaults */
     jc_update_params(inst);
+    jc_pull_params(inst);
 
     jc_log("Instance created");
     return inst;
@@ -265,67 +915,667 @@ static void *v2_create_instance(const char *module_dir, const char *config_json)
 static void v2_destroy_instance(void *instance) {
     if (!instance) return;
     jc_log("Destroying instance");
-    free(instance);
+    jc_instance_t *inst = (jc_instance_t *)instance;
+    delay_free(&inst->delay);
+    free(inst);
+}
+
+/*
+ * Half-rate wet path: decimate the mono sum by 2, run the pre-filter,
+ * ring, taps and post-filters on the half-rate stream, then
+ * interpolate the result back up. Everything between the resamplers
+ * does half the work, which is what pays for them in every mode; the
+ * wet signal is band-limited to ~fs * 0.18 and delayed by HB_ORDER
+ * extra samples.
+ */
+static void jc_stage_wet_half(jc_instance_t *inst, int n) {
+    int m = hb_decimate(&inst->hb_down, inst->mono, inst->half, n);
+    jc_stage_prefilter(inst, inst->half, m);
+    int pos = delay_write_block(&inst->delay, inst->half, m);
+    jc_stage_taps(inst, pos, m);
+    jc_stage_post(inst, m);
+
+    hb_interpolate_stereo(&inst->hb_up_l, &inst->hb_up_r, inst->wet_l, inst->wet_r, m,
+                          inst->wet_l, inst->wet_r, n);
+}
+
+/*
+ * Zero all signal state (ring, filters, allpass, BBD, resampler
+ * history). Resampler phase and the LFOs are kept.
+ */
+static void jc_clear_state(jc_instance_t *inst) {
+    jc_clear_ring(inst);
+    inst->pre_lpf.state = 0.0f;
+    inst->post_lpf_l.state = 0.0f;
+    inst->post_lpf_r.state = 0.0f;
+    memset(inst->ap_y, 0, sizeof(inst->ap_y));
+    memset(inst->bbd, 0, sizeof(inst->bbd));
+    memset(&inst->bbd_in, 0, sizeof(inst->bbd_in));
+    memset(inst->hb_down.ev, 0, sizeof(inst->hb_down.ev));
+    memset(inst->hb_down.od, 0, sizeof(inst->hb_down.od));
+    memset(inst->hb_up_l.hist, 0, sizeof(inst->hb_up_l.hist));
+    memset(inst->hb_up_r.hist, 0, sizeof(inst->hb_up_r.hist));
+    inst->hb_up_l.pending = 0.0f;
+    inst->hb_up_r.pending = 0.0f;
+    inst->q_pre = 0;
+    inst->q_post_l = 0;
+    inst->q_post_r = 0;
+}
+
+/*
+ * Every path into recursive state runs through the pre filter (input)
+ * or the post filters (wet), so a NaN/Inf anywhere shows up in one of
+ * their three states by the end of the chunk.
+ */
+static int jc_state_nonfinite(const jc_instance_t *inst) {
+    return jc_nonfinite(inst->pre_lpf.state) |
+           jc_nonfinite(inst->post_lpf_l.state) |
+           jc_nonfinite(inst->post_lpf_r.state);
+}
+
+/* Reset poisoned state and silence the n rendered frames of this chunk */
+static void jc_quarantine(jc_instance_t *inst, int n) {
+    jc_clear_state(inst);
+    memset(inst->wet_l, 0, (size_t)n * sizeof(float));
+    memset(inst->wet_r, 0, (size_t)n * sizeof(float));
+    atomic_fetch_add_explicit(&inst->nonfinite_resets, 1u, memory_order_relaxed);
+}
+
+/* Mix settled at 0: the output is the dry input, bit for bit */
+static int jc_bypassed(const jc_instance_t *inst) {
+    return !inst->dry_g.left && !inst->wet_g.left &&
+           inst->dry_g.value == 1.0f && inst->wet_g.value == 0.0f;
+}
+
+/*
+ * Bypass: keep the wet path's history current without computing taps.
+ * The ring is fed and the LFOs advance, so raising the mix reads valid
+ * delayed signal at the right phase. For the BBD model the bucket chain
+ * is the history, so its stage still runs; on the half-rate path only
+ * the taps the interpolator keeps as history are computed. The post
+ * filters restart from zero, under a wet gain that ramps in from 0.
+ */
+static void jc_stage_feed(jc_instance_t *inst, int n) {
+    if (inst->model_on == JC_MODEL_BBD) {
+        jc_stage_taps(inst, 0, n);
+    } else if (inst->half_rate_on) {
+        int m = hb_decimate(&inst->hb_down, inst->mono, inst->half, n);
+        jc_stage_prefilter(inst, inst->half, m);
+        int pos = delay_write_block(&inst->delay, inst->half, m);
+        int k = m < HB_HALF_HIST ? m : HB_HALF_HIST;
+        jc_stage_lfos(inst, m - k, 0, 0);
+        jc_stage_taps(inst, (pos + m - k) & inst->delay.mask, k);
+        hb_interp_skip(&inst->hb_up_l, inst->wet_l, k, m, n);
+        hb_interp_skip(&inst->hb_up_r, inst->wet_r, k, m, n);
+    } else {
+        delay_write_block(&inst->delay, inst->mono, n);
+        jc_stage_lfos(inst, n, 0, 0);
+    }
+    inst->post_lpf_l.state = 0.0f;
+    inst->post_lpf_r.state = 0.0f;
+}
+
+/*
+ * Shared DSP core: in_l/in_r -> wet_l/wet_r for one chunk. Returns 0
+ * when the chunk is bypassed and the caller's buffer is already the
+ * output.
+ */
+static int jc_render_chunk(jc_instance_t *inst, int n) {
+    jc_stage_premix(inst, n);
+    if (jc_bypassed(inst)) {
+        jc_stage_feed(inst, n);
+        if (jc_state_nonfinite(inst)) jc_quarantine(inst, 0);
+        return 0;
+    }
+
+    if (inst->model_on == JC_MODEL_BBD) {
+        jc_stage_taps(inst, 0, n);
+        jc_stage_post(inst, n);
+    } else if (inst->half_rate_on) {
+        jc_stage_wet_half(inst, n);
+    } else {
+        int pos = delay_write_block(&inst->delay, inst->mono, n);
+        jc_stage_taps(inst, pos, n);
+        jc_stage_post(inst, n);
+    }
+    jc_stage_mix(inst, n);
+    if (jc_state_nonfinite(inst)) jc_quarantine(inst, n);
+    return 1;
+}
+
+/* Fixed-point counterpart of jc_render_chunk, int16 in place */
+static void jc_render_chunk_q15(jc_instance_t *inst, int16_t *io, int n) {
+    jc_stage_premix_q15(inst, io, n);
+    int pos = delay_write_block_q15(&inst->delay, inst->q_mono, n);
+
+    /* Bypass: as jc_stage_feed, leaving io untouched */
+    if (jc_bypassed(inst)) {
+        jc_stage_lfos(inst, n, 0, 0);
+        inst->q_post_l = 0;
+        inst->q_post_r = 0;
+        return;
+    }
+
+    jc_core_taps_t t = jc_core_state(inst);
+    (inst->gain_a.left || inst->gain_b.left ? inst->cur.tap_stage_q15_ramp
+                                            : inst->cur.tap_stage_q15)
+        (&t, delay_block_base_q15(&inst->delay, pos), n);
+    jc_stage_post_q15(inst, n);
+    jc_stage_mix_q15(inst, io, n);
+}
+
+/* Audio thread: switch sample engine, starting the new one from silence */
+static void jc_set_engine(jc_instance_t *inst, int engine) {
+    inst->engine_on = engine;
+    jc_clear_state(inst);
+}
+
+/* --- Silence and idle --- */
+
+/* int16 has nothing between zero and -90 dBFS, so silence is all zeros */
+static int jc_silent_s16(const int16_t *io, int n) {
+    int acc = 0;
+    for (int i = 0; i < 2 * n; i++) acc |= io[i];
+    return acc == 0;
+}
+
+static int jc_silent_f32(const float *io, int n) {
+    float peak = 0.0f;
+    for (int i = 0; i < 2 * n; i++) peak = fmaxf(peak, fabsf(io[i]));
+    return peak < JC_SILENCE;
+}
+
+/*
+ * Filter state that still carries the tail is below JC_SILENCE; the
+ * ring is covered by tail_frames. The idle engine's state is zero.
+ */
+static int jc_tail_drained(const jc_instance_t *inst) {
+    const int32_t q_silence = (int32_t)(JC_SILENCE * 32767.0f * (1 << JC_Q_SHIFT));
+    float peak = fmaxf(fabsf(inst->pre_lpf.state),
+                       fmaxf(fabsf(inst->post_lpf_l.state), fabsf(inst->post_lpf_r.state)));
+    return peak < JC_SILENCE &&
+           abs(inst->q_pre) < q_silence &&
+           abs(inst->q_post_l) < q_silence &&
+           abs(inst->q_post_r) < q_silence;
+}
+
+/*
+ * Zero the leftover sub-threshold state so resuming starts exactly as a
+ * fresh instance would, apart from the LFO phase. Resampler phase
+ * (parity, pending flag) is kept; only its history is cleared.
+ */
+static void jc_enter_idle(jc_instance_t *inst) {
+    inst->run_state = JC_RUN_IDLE;
+    jc_clear_state(inst);
+}
+
+/*
+ * Skip an idle chunk: advance LFO phase (and the resampler phase on
+ * the half-rate path) by what rendering it would have, and settle any
+ * ramps, which have nothing audible to smooth.
+ */
+static void jc_idle_advance(jc_instance_t *inst, int n) {
+    int ticks = n;
+
+    if (inst->half_rate_on) {
+        ticks = hb_decim_skip(&inst->hb_down, n);
+        hb_interp_skip(&inst->hb_up_l, NULL, 0, ticks, n);
+        hb_interp_skip(&inst->hb_up_r, NULL, 0, ticks, n);
+    }
+    jc_stage_lfos(inst, ticks, 0, 0);
+
+    if (inst->gain_a.left || inst->gain_b.left || inst->dry_g.left ||
+        inst->wet_g.left || inst->pre_alpha.left || inst->post_alpha.left)
+        jc_snap_params(inst);
+}
+
+/*
+ * Audio thread, before a chunk: returns 1 if it can be skipped, which
+ * leaves the (silent) buffer as it is. Any signal reactivates.
+ */
+static int jc_idle_skip(jc_instance_t *inst, int silent, int n) {
+    if (!silent) {
+        inst->run_state = JC_RUN_ACTIVE;
+        inst->quiet_frames = 0;
+        return 0;
+    }
+    if (inst->run_state != JC_RUN_IDLE) return 0;
+    jc_idle_advance(inst, n);
+    return 1;
+}
+
+/* Audio thread, after rendering a chunk: count silence, go idle once drained */
+static void jc_idle_track(jc_instance_t *inst, int silent, int n) {
+    if (!silent) return;
+    inst->run_state = JC_RUN_TAIL;
+    if (inst->quiet_frames < inst->cur.tail_frames) inst->quiet_frames += n;
+    if (inst->quiet_frames >= inst->cur.tail_frames && jc_tail_drained(inst))
+        jc_enter_idle(inst);
+}
+
+/* Audio thread, before any block: latest params; from here on they ramp */
+static void jc_begin_block(jc_instance_t *inst) {
+    jc_pull_params(inst);
+    inst->primed = 1;
+}
+
+/* Audio thread, before an int16 block: latest params and engine */
+static void jc_begin_block_s16(jc_instance_t *inst) {
+    jc_begin_block(inst);
+    if (inst->cur.engine != inst->engine_on)
+        jc_set_engine(inst, inst->cur.engine);
+}
+
+/* One int16 chunk in place through the instance's engine */
+static void jc_render_s16(jc_instance_t *inst, int16_t *io, int n) {
+    if (inst->engine_on == JC_ENGINE_FIXED) {
+        jc_render_chunk_q15(inst, io, n);
+    } else {
+        jc_s16_to_f32(io, inst->in_l, inst->in_r, n);
+        if (jc_render_chunk(inst, n))
+            jc_f32_to_s16(inst->wet_l, inst->wet_r, io, n);
+    }
+}
+
+/* One interleaved float chunk in place; float blocks always run float */
+static void jc_render_f32(jc_instance_t *inst, float *io, int n) {
+    jc_f32i_to_f32(io, inst->in_l, inst->in_r, n);
+    if (jc_render_chunk(inst, n))
+        jc_f32_to_f32i(inst->wet_l, inst->wet_r, io, n);
+}
+
+/* --- Batched instances --- */
+
+/*
+ * Up to JC_LANES instances advanced in lockstep, one per SIMD lane:
+ * signals, filter states, LFO values and tap delays are
+ * structure-of-arrays vectors, so the recursive filters run per frame
+ * four instances wide. Only the ring reads stay a per-lane gather.
+ * Covers the steady float path at full rate with linear taps; lanes
+ * compute both tap pairs and let a zero mode gain drop the unused one.
+ * The per-frame filters round differently from fo_lpf_block's closed
+ * form, so output is within 1 LSB of process_block rather than
+ * identical.
+ */
+#define JC_LANES     4
+#define JC_LANES_MIN 3      /* fewer: padding costs more than lanes save */
+
+/* Nothing ramping, not bypassed: what jc_render_chunk_lanes implements */
+static int jc_batchable(const jc_instance_t *inst) {
+    return inst->engine_on == JC_ENGINE_FLOAT && inst->model_on == JC_MODEL_IDEAL &&
+           inst->quality_on == JC_INTERP_LINEAR && !inst->half_rate_on &&
+           !inst->pre_alpha.left && !inst->post_alpha.left &&
+           !inst->gain_a.left && !inst->gain_b.left &&
+           !inst->dry_g.left && !inst->wet_g.left && !jc_bypassed(inst);
+}
+
+/* src[l][0..n) into lane l of dst[0..n) */
+static inline void jc_lanes_in(jc_v4f *dst, const float *const src[JC_LANES], int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        jc_v4f r[4] = { jc_v4f_load(src[0] + i), jc_v4f_load(src[1] + i),
+                        jc_v4f_load(src[2] + i), jc_v4f_load(src[3] + i) };
+        jc_v4f_transpose4(r);
+        for (int j = 0; j < 4; j++) dst[i + j] = r[j];
+    }
+    for (; i < n; i++)
+        for (int l = 0; l < JC_LANES; l++) dst[i][l] = src[l][i];
+}
+
+/* Lane l of src[0..n) into dst[l][0..n), for the first k lanes */
+static inline void jc_lanes_out(float *const dst[JC_LANES], const jc_v4f *src, int k, int n) {
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        jc_v4f r[4] = { src[i], src[i + 1], src[i + 2], src[i + 3] };
+        jc_v4f_transpose4(r);
+        for (int l = 0; l < k; l++) jc_v4f_store(dst[l] + i, r[l]);
+    }
+    for (; i < n; i++)
+        for (int l = 0; l < k; l++) dst[l][i] = src[i][l];
+}
+
+/*
+ * jc_render_chunk for k (up to JC_LANES) batchable instances whose
+ * in_l/in_r are filled; leaves the mixed output in each one's
+ * wet_l/wet_r. Lanes past k repeat lane 0 and are never stored back.
+ */
+static void jc_render_chunk_lanes(jc_instance_t *const *lane, int k, int n) {
+    jc_v4f x_l[JC_CHUNK] JC_ALIGNED;
+    jc_v4f x_r[JC_CHUNK] JC_ALIGNED;
+    jc_v4f y_l[JC_CHUNK] JC_ALIGNED;
+    jc_v4f y_r[JC_CHUNK] JC_ALIGNED;
+    jc_v4f v_1[JC_CHUNK] JC_ALIGNED;
+    jc_v4f v_2[JC_CHUNK] JC_ALIGNED;
+    jc_instance_t *ln[JC_LANES];
+    const float *src[4][JC_LANES];
+    float *dst[2][JC_LANES];
+    const float *p[JC_LANES];
+    jc_v4f pre_a, post_a, pre_s, post_l, post_r, ga, gb, dry, wet, dt_min, dt_rng;
+
+    for (int l = 0; l < JC_LANES; l++) {
+        jc_instance_t *inst = ln[l] = lane[l < k ? l : 0];
+        if (l < k) {
+            lfo_fill(&inst->lfo1, inst->lfo1_v, n);
+            lfo_fill(&inst->lfo2, inst->lfo2_v, n);
+        }
+        pre_a[l]  = inst->pre_lpf.alpha;
+        pre_s[l]  = inst->pre_lpf.state;
+        post_a[l] = inst->post_lpf_l.alpha;
+        post_l[l] = inst->post_lpf_l.state;
+        post_r[l] = inst->post_lpf_r.state;
+        ga[l]     = inst->gain_a.value;
+        gb[l]     = inst->gain_b.value;
+        dry[l]    = inst->dry_g.value;
+        wet[l]    = inst->wet_g.value;
+        dt_min[l] = inst->dt_min;
+        dt_rng[l] = inst->dt_rng;
+        src[0][l] = inst->in_l;
+        src[1][l] = inst->in_r;
+        src[2][l] = inst->lfo1_v;
+        src[3][l] = inst->lfo2_v;
+        dst[0][l] = inst->wet_l;
+        dst[1][l] = inst->wet_r;
+    }
+    jc_lanes_in(x_l, src[0], n);
+    jc_lanes_in(x_r, src[1], n);
+    jc_lanes_in(v_1, src[2], n);
+    jc_lanes_in(v_2, src[3], n);
+
+    /* Premix: mono sum -> soft-limit -> pre-filter, then the rings */
+    for (int i = 0; i < n; i++) {
+        jc_v4f m = (x_l[i] + x_r[i]) * 0.5f;
+        m = soft_limit_v4(m);
+        pre_s = jc_v4f_madd(pre_a, m - pre_s, pre_s);
+        y_l[i] = pre_s;
+    }
+    for (int l = 0; l < k; l++) dst[0][l] = ln[l]->mono;
+    jc_lanes_out(dst[0], y_l, k, n);
+    for (int l = 0; l < JC_LANES; l++) {
+        jc_instance_t *inst = ln[l];
+        if (l < k) {
+            int at = delay_write_block(&inst->delay, inst->mono, n);
+            p[l] = delay_block_base(&inst->delay, at);
+        } else {
+            p[l] = p[0];
+        }
+        dst[0][l] = inst->wet_l;
+    }
+
+    /* Taps -> post-filter -> mix */
+    for (int i = 0; i < n; i++) {
+        jc_v4f d[4] = {
+            jc_v4f_madd(dt_rng, v_1[i], dt_min), jc_v4f_madd(dt_rng, 1.0f - v_1[i], dt_min),
+            jc_v4f_madd(dt_rng, v_2[i], dt_min), jc_v4f_madd(dt_rng, 1.0f - v_2[i], dt_min)
+        };
+        jc_v4f tap[4];
+
+        for (int t = 0; t < 4; t++) {
+            jc_v4i di = jc_v4f_to_v4i(d[t]);
+            jc_v4f frac = d[t] - jc_v4i_to_v4f(di);
+            jc_v4f y0, y1;
+            for (int l = 0; l < JC_LANES; l++) {
+                const float *q = p[l] + i - di[l];
+                y0[l] = q[0];
+                y1[l] = q[-1];
+            }
+            tap[t] = jc_v4f_madd(y1, frac, y0 * (1.0f - frac));
+        }
+
+        jc_v4f in_l = jc_v4f_madd(ga, tap[0], gb * tap[2]);
+        jc_v4f in_r = jc_v4f_madd(ga, tap[1], gb * tap[3]);
+        post_l = jc_v4f_madd(post_a, in_l - post_l, post_l);
+        post_r = jc_v4f_madd(post_a, in_r - post_r, post_r);
+        y_l[i] = jc_v4f_madd(x_l[i], dry, post_l * wet);
+        y_r[i] = jc_v4f_madd(x_r[i], dry, post_r * wet);
+    }
+    jc_lanes_out(dst[0], y_l, k, n);
+    jc_lanes_out(dst[1], y_r, k, n);
+
+    for (int l = 0; l < k; l++) {
+        jc_instance_t *inst = ln[l];
+        inst->pre_lpf.state    = pre_s[l];
+        inst->post_lpf_l.state = post_l[l];
+        inst->post_lpf_r.state = post_r[l];
+        if (jc_state_nonfinite(inst)) jc_quarantine(inst, n);
+    }
+}
+
+/* k batchable int16 chunks in place through the lane kernel */
+static void jc_render_s16_lanes(jc_instance_t *const *lane, int16_t *const *io, int k, int n) {
+    for (int l = 0; l < k; l++)
+        jc_s16_to_f32(io[l], lane[l]->in_l, lane[l]->in_r, n);
+    jc_render_chunk_lanes(lane, k, n);
+    for (int l = 0; l < k; l++)
+        jc_f32_to_s16(lane[l]->wet_l, lane[l]->wet_r, io[l], n);
+}
+
+/* --- Process kernels --- */
+
+/*
+ * The pipeline above is written once and compiled per instruction set.
+ * JC_KERNEL instantiates a kernel: flatten inlines the whole chunk
+ * (stages, filters, ring, conversions) into functions carrying the
+ * kernel's target attribute, and the BBD stages, which are reached
+ * through the params snapshot, get their own flattened copies. The
+ * ideal model's tap stages are the core's (jc_core.cpp), built with
+ * the same attribute as jc_core_<k>. The control and idle paths stay
+ * on the build's baseline.
+ *
+ * Kernels are listed best first; jc_select_kernel takes the first one
+ * the CPU supports. All of them compute the same thing; with FMA
+ * contraction results can differ in the last float bit.
+ */
+#define JC_KERNEL_TAP(k, attr, stage)                                       \
+static attr void stage##_##k(jc_instance_t *inst, int n) {                  \
+    stage(inst, n);                                                         \
+}
+
+#define JC_KERNEL(k, label, attr, supported_fn)                             \
+JC_KERNEL_TAP(k, attr, jc_stage_bbd_i)                                      \
+JC_KERNEL_TAP(k, attr, jc_stage_bbd_i_ii)                                   \
+JC_KERNEL_TAP(k, attr, jc_stage_bbd_ii)                                     \
+JC_KERNEL_TAP(k, attr, jc_stage_bbd_ramp)                                   \
+static attr void jc_render_s16_##k(jc_instance_t *inst, int16_t *io, int n) {\
+    jc_render_s16(inst, io, n);                                             \
+}                                                                           \
+static attr void jc_render_f32_##k(jc_instance_t *inst, float *io, int n) { \
+    jc_render_f32(inst, io, n);                                             \
+}                                                                           \
+static attr void jc_render_s16_lanes_##k(jc_instance_t *const *lane,       \
+                                         int16_t *const *io, int count, int n) {\
+    jc_render_s16_lanes(lane, io, count, n);                                \
+}                                                                           \
+/* The BBD engine samples its input itself; quality does not apply */     \
+static const jc_bbd_stage_fn TAP_STAGE_BBD_##k[4] = {                       \
+    jc_stage_bbd_i_##k, jc_stage_bbd_i_ii_##k, jc_stage_bbd_ii_##k,         \
+    jc_stage_bbd_ramp_##k                                                   \
+};                                                                          \
+static const jc_kernel_t JC_KERNEL_##k = {                                  \
+    label, supported_fn, jc_render_s16_##k, jc_render_f32_##k,              \
+    jc_render_s16_lanes_##k, TAP_STAGE_BBD_##k, &jc_core_##k                \
+};
+
+static int jc_cpu_any(void) {
+    return 1;
+}
+
+#if defined(__x86_64__)
+static int jc_cpu_avx2(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+static int jc_cpu_sse41(void) {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.1");
+}
+
+JC_KERNEL(avx2,  "avx2",   JC_KERNEL_ATTR_AVX2,  jc_cpu_avx2)
+JC_KERNEL(sse41, "sse4.1", JC_KERNEL_ATTR_SSE41, jc_cpu_sse41)
+#elif defined(__aarch64__)
+/*
+ * ARMv8.2-A with FP16 arithmetic (scalar and vector) and dot product:
+ * Cortex-A55/A76 and later, not the Move's A72. AT_HWCAP reports them.
+ */
+static int jc_cpu_v82(void) {
+#if defined(__linux__) && defined(HWCAP_FPHP) && defined(HWCAP_ASIMDHP) && defined(HWCAP_ASIMDDP)
+    const unsigned long need = HWCAP_FPHP | HWCAP_ASIMDHP | HWCAP_ASIMDDP;
+    return (getauxval(AT_HWCAP) & need) == need;
+#else
+    return 0;
+#endif
+}
+
+JC_KERNEL(v82, "armv8.2-a+fp16+dotprod", JC_KERNEL_ATTR_V82, jc_cpu_v82)
+#endif
+
+/* The build's own target: armv8-a NEON on the Move */
+JC_KERNEL(base, JC_HAVE_NEON ? "neon" : "generic", JC_KERNEL_ATTR_BASE, jc_cpu_any)
+
+/*
+ * Reference: the same code with the auto-vectorizer off (the explicit
+ * vector code in jc_dsp.h keeps its vectors). Never picked on its own;
+ * jc-bench compares it against the others.
+ */
+JC_KERNEL(scalar, "scalar", JC_KERNEL_ATTR_SCALAR, jc_cpu_any)
+
+static const jc_kernel_t *const JC_KERNELS[] = {
+#if defined(__x86_64__)
+    &JC_KERNEL_avx2, &JC_KERNEL_sse41,
+#elif defined(__aarch64__)
+    &JC_KERNEL_v82,
+#endif
+    &JC_KERNEL_base, &JC_KERNEL_scalar
+};
+
+#define JC_NUM_KERNELS ((int)(sizeof(JC_KERNELS) / sizeof(JC_KERNELS[0])))
+
+/* Pick the best kernel for this CPU once; instances take it at create */
+static void jc_select_kernel(void) {
+    if (g_kernel) return;
+    for (int i = 0; i < JC_NUM_KERNELS; i++) {
+        if (JC_KERNELS[i]->supported()) {
+            g_kernel = JC_KERNELS[i];
+            break;
+        }
+    }
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "Process kernel: %s", g_kernel->name);
+    jc_log(msg);
+}
+
+/*
+ * The chunk loop behind every entry point: count instances, each on its
+ * own interleaved buffer (int16, or float if f32) of frames frames, in
+ * groups of JC_LANES. Per chunk, idle instances are skipped; with
+ * enough instances, int16 ones in the batchable steady state on the
+ * selected kernel share the lane kernel, the rest (ramping, bypassed,
+ * fixed engine, other models) render alone. Params are already pulled.
+ * Inlined so f32 and the single-instance case fold away.
+ */
+static inline __attribute__((always_inline))
+void jc_process_chunks(void *const *instances, void *const *audio, int count,
+                       int frames, int f32) {
+    const int batch = !f32 && count >= JC_LANES_MIN;
+
+    for (int g = 0; g < count; g += JC_LANES) {
+        int end = g + JC_LANES < count ? g + JC_LANES : count;
+
+        for (int base = 0; base < frames; base += JC_CHUNK) {
+            int n = frames - base;
+            if (n > JC_CHUNK) n = JC_CHUNK;
+
+            jc_instance_t *lane[JC_LANES];
+            int16_t *lane_io[JC_LANES];
+            int lane_silent[JC_LANES];
+            int k = 0;
+
+            for (int j = g; j < end; j++) {
+                jc_instance_t *inst = (jc_instance_t *)instances[j];
+                if (!inst) continue;
+
+                if (f32) {
+                    float *io = (float *)audio[j] + base * 2;
+                    int silent = jc_silent_f32(io, n);
+                    if (jc_idle_skip(inst, silent, n)) continue;
+                    inst->kernel->render_f32(inst, io, n);
+                    jc_idle_track(inst, silent, n);
+                    continue;
+                }
+
+                int16_t *io = (int16_t *)audio[j] + base * 2;
+                int silent = jc_silent_s16(io, n);
+                if (jc_idle_skip(inst, silent, n)) continue;
+
+                if (batch && inst->kernel == g_kernel && jc_batchable(inst)) {
+                    lane[k] = inst;
+                    lane_io[k] = io;
+                    lane_silent[k] = silent;
+                    k++;
+                    continue;
+                }
+                inst->kernel->render_s16(inst, io, n);
+                jc_idle_track(inst, silent, n);
+            }
+            if (!batch) continue;
+
+            if (k < JC_LANES_MIN) {
+                for (int l = 0; l < k; l++)
+                    g_kernel->render_s16(lane[l], lane_io[l], n);
+            } else {
+                g_kernel->render_s16_lanes(lane, lane_io, k, n);
+            }
+            for (int l = 0; l < k; l++)
+                jc_idle_track(lane[l], lane_silent[l], n);
+        }
+    }
 }
 
 static void v2_process_block(void *instance, int16_t *audio_inout, int frames) {
     jc_instance_t *inst = (jc_instance_t *)instance;
     if (!inst) return;
 
-    const float ga = inst->gain_a;
-    const float gb = inst->gain_b;
+    uint64_t fpenv = jc_ftz_enter();
+    jc_begin_block_s16(inst);
 
-    /* Equal-power crossfade for dry/wet */
-    const float dry_g = fast_sqrt(1.0f - inst->mix);
-    const float wet_g = fast_sqrt(inst->mix);
+    void *io = audio_inout;
+    jc_process_chunks(&instance, &io, 1, frames, 0);
 
-    for (int i = 0; i < frames; i++) {
-        float in_l = (float)audio_inout[i * 2]     / 32768.0f;
-        float in_r = (float)audio_inout[i * 2 + 1] / 32768.0f;
+    jc_ftz_leave(fpenv);
+}
 
-        /*
-         * Mono sum -> soft-limit -> pre-filter -> delay write
-         * The Juno-60 sums to mono before the BBD (no compander).
-         */
-        float mono = (in_l + in_r) * 0.5f;
-        mono = fo_lpf_process(&inst->pre_lpf, soft_limit(mono));
-        delay_write(&inst->delay, mono);
+/*
+ * Process count instances, each on its own buffer of the same length,
+ * with the same result as calling process_block on each (to 1 LSB, see
+ * jc_render_chunk_lanes).
+ */
+static void v4_process_blocks_batched(void **instances, int16_t **audio_inout,
+                                      int count, int frames) {
+    uint64_t fpenv = jc_ftz_enter();
+    for (int j = 0; j < count; j++)
+        if (instances[j]) jc_begin_block_s16((jc_instance_t *)instances[j]);
 
-        /* Advance LFOs */
-        float v1 = lfo_tick(&inst->lfo1);
-        float v2 = lfo_tick(&inst->lfo2);
+    jc_process_chunks(instances, (void *const *)audio_inout, count, frames, 0);
 
-        /*
-         * Read delay with same range for L and R, but inverted LFO
-         * for the right channel (180-degree phase opposition),
-         * matching the Juno-60's dual-BBD stereo architecture.
-         */
-        float tap1_l = delay_read_frac(&inst->delay, DT_MIN_S + DT_RNG_S * v1);
-        float tap1_r = delay_read_frac(&inst->delay, DT_MIN_S + DT_RNG_S * (1.0f - v1));
-        float tap2_l = delay_read_frac(&inst->delay, DT_MIN_S + DT_RNG_S * v2);
-        float tap2_r = delay_read_frac(&inst->delay, DT_MIN_S + DT_RNG_S * (1.0f - v2));
+    jc_ftz_leave(fpenv);
+}
 
-        /* Combine taps with mode gains */
-        float wet_l = tap1_l * ga + tap2_l * gb;
-        float wet_r = tap1_r * ga + tap2_r * gb;
+static void v3_process_block_f32(void *instance, float *audio_inout, int frames) {
+    jc_instance_t *inst = (jc_instance_t *)instance;
+    if (!inst) return;
 
-        /* Post-filter */
-        wet_l = fo_lpf_process(&inst->post_lpf_l, wet_l);
-        wet_r = fo_lpf_process(&inst->post_lpf_r, wet_r);
+    uint64_t fpenv = jc_ftz_enter();
+    jc_begin_block(inst);
 
-        /* Mix dry and wet */
-        float out_l = in_l * dry_g + wet_l * wet_g;
-        float out_r = in_r * dry_g + wet_r * wet_g;
+    /* Float blocks always run the float engine */
+    if (inst->engine_on != JC_ENGINE_FLOAT)
+        jc_set_engine(inst, JC_ENGINE_FLOAT);
 
-        /* Clamp */
-        if (out_l >  1.0f) out_l =  1.0f;
-        if (out_l < -1.0f) out_l = -1.0f;
-        if (out_r >  1.0f) out_r =  1.0f;
-        if (out_r < -1.0f) out_r = -1.0f;
+    void *io = audio_inout;
+    jc_process_chunks(&instance, &io, 1, frames, 1);
 
-        audio_inout[i * 2]     = (int16_t)(out_l * 32767.0f);
-        audio_inout[i * 2 + 1] = (int16_t)(out_r * 32767.0f);
-    }
+    jc_ftz_leave(fpenv);
 }
 
 /* --- JSON helper --- */
@@ -344,6 +1594,17 @@ static int json_get_number(const char *json, const char *key, float *out) {
 /* --- Parameter handling --- */
 
 static const char *mode_names[3] = { "I", "I+II", "II" };
+static const char *switch_names[2] = { "off", "on" };
+static const char *model_names[2] = { "ideal", "bbd" };
+static const char *quality_names[3] = { "linear", "hermite", "thiran" };
+static const char *engine_names[2] = { "float", "fixed" };
+
+/* Accept "off"/"on" or a number (non-zero is on) */
+static int parse_switch(const char *val) {
+    if (strcmp(val, "on") == 0)  return 1;
+    if (strcmp(val, "off") == 0) return 0;
+    return atoi(val) != 0;
+}
 
 static void v2_set_param(void *instance, const char *key, const char *val) {
     jc_instance_t *inst = (jc_instance_t *)instance;
@@ -359,6 +1620,15 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
         }
         if (json_get_number(val, "mix", &v) == 0) inst->mix = v;
         if (json_get_number(val, "brightness", &v) == 0) inst->brightness = v;
+        if (json_get_number(val, "half_rate", &v) == 0) inst->half_rate = (v != 0.0f);
+        if (json_get_number(val, "model", &v) == 0)
+            inst->model = (v != 0.0f) ? JC_MODEL_BBD : JC_MODEL_IDEAL;
+        if (json_get_number(val, "engine", &v) == 0)
+            inst->engine = (v != 0.0f) ? JC_ENGINE_FIXED : JC_ENGINE_FLOAT;
+        if (json_get_number(val, "quality", &v) == 0) {
+            int q = (int)v;
+            if (q >= JC_INTERP_LINEAR && q <= JC_INTERP_THIRAN) inst->quality = q;
+        }
         jc_update_params(inst);
         return;
     }
@@ -384,6 +1654,26 @@ static void v2_set_param(void *instance, const char *key, const char *val) {
         if (v < 0.0f) v = 0.0f;
         if (v > 1.0f) v = 1.0f;
         inst->brightness = v;
+    } else if (strcmp(key, "half_rate") == 0) {
+        inst->half_rate = parse_switch(val);
+    } else if (strcmp(key, "model") == 0) {
+        if (strcmp(val, "ideal") == 0)    inst->model = JC_MODEL_IDEAL;
+        else if (strcmp(val, "bbd") == 0) inst->model = JC_MODEL_BBD;
+        else inst->model = atoi(val) ? JC_MODEL_BBD : JC_MODEL_IDEAL;
+    } else if (strcmp(key, "engine") == 0) {
+        if (strcmp(val, "float") == 0)      inst->engine = JC_ENGINE_FLOAT;
+        else if (strcmp(val, "fixed") == 0) inst->engine = JC_ENGINE_FIXED;
+        else inst->engine = atoi(val) ? JC_ENGINE_FIXED : JC_ENGINE_FLOAT;
+    } else if (strcmp(key, "quality") == 0) {
+        if (strcmp(val, "linear") == 0)       inst->quality = JC_INTERP_LINEAR;
+        else if (strcmp(val, "hermite") == 0) inst->quality = JC_INTERP_HERMITE;
+        else if (strcmp(val, "thiran") == 0)  inst->quality = JC_INTERP_THIRAN;
+        else {
+            int q = atoi(val);
+            if (q < JC_INTERP_LINEAR) q = JC_INTERP_LINEAR;
+            if (q > JC_INTERP_THIRAN) q = JC_INTERP_THIRAN;
+            inst->quality = q;
+        }
     }
 
     jc_update_params(inst);
@@ -399,12 +1689,35 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
         return snprintf(buf, buf_len, "%.2f", inst->mix);
     } else if (strcmp(key, "brightness") == 0) {
         return snprintf(buf, buf_len, "%.2f", inst->brightness);
+    } else if (strcmp(key, "half_rate") == 0) {
+        return snprintf(buf, buf_len, "%s", switch_names[inst->half_rate]);
+    } else if (strcmp(key, "model") == 0) {
+        return snprintf(buf, buf_len, "%s", model_names[inst->model]);
+    } else if (strcmp(key, "quality") == 0) {
+        return snprintf(buf, buf_len, "%s", quality_names[inst->quality]);
+    } else if (strcmp(key, "engine") == 0) {
+        return snprintf(buf, buf_len, "%s", engine_names[inst->engine]);
+    } else if (strcmp(key, "kernel") == 0) {
+        return snprintf(buf, buf_len, "%s", inst->kernel->name);
+    } else if (strcmp(key, "latency_samples") == 0) {
+        /* Extra wet-path delay from the resampler; dry is never delayed */
+        int half = inst->half_rate && inst->model == JC_MODEL_IDEAL;
+        return snprintf(buf, buf_len, "%d", half ? HB_ORDER : 0);
+    } else if (strcmp(key, "nonfinite_resets") == 0) {
+        return snprintf(buf, buf_len, "%u",
+                        atomic_load_explicit(&inst->nonfinite_resets, memory_order_relaxed));
+    } else if (strcmp(key, "tail_samples") == 0) {
+        /* Output after the input goes silent; hosts may stop calling after it */
+        float pre_alpha, post_alpha;
+        jc_filter_alphas(inst, &pre_alpha, &post_alpha);
+        return snprintf(buf, buf_len, "%d", jc_tail_frames(inst, pre_alpha, post_alpha));
     } else if (strcmp(key, "name") == 0) {
         return snprintf(buf, buf_len, "Junologue Chorus");
     } else if (strcmp(key, "state") == 0) {
         return snprintf(buf, buf_len,
-            "{\"mode\":%d,\"mix\":%.4f,\"brightness\":%.4f}",
-            inst->mode, inst->mix, inst->brightness);
+            "{\"mode\":%d,\"mix\":%.4f,\"brightness\":%.4f,\"half_rate\":%d,\"model\":%d,\"quality\":%d,\"engine\":%d}",
+            inst->mode, inst->mix, inst->brightness, inst->half_rate, inst->model,
+            inst->quality, inst->engine);
     } else if (strcmp(key, "ui_hierarchy") == 0) {
         const char *h = "{"
             "\"modes\":null,"
@@ -412,7 +1725,7 @@ static int v2_get_param(void *instance, const char *key, char *buf, int buf_len)
                 "\"root\":{"
                     "\"children\":null,"
                     "\"knobs\":[\"mode\",\"mix\",\"brightness\"],"
-                    "\"params\":[\"mode\",\"mix\",\"brightness\"]"
+                    "\"params\":[\"mode\",\"mix\",\"brightness\",\"model\",\"quality\",\"half_rate\",\"engine\"]"
                 "}"
             "}"
         "}";
@@ -435,6 +1748,7 @@ static audio_fx_api_v2_t g_fx_api_v2;
 
 audio_fx_api_v2_t *move_audio_fx_init_v2(const host_api_v1_t *host) {
     g_host = host;
+    jc_select_kernel();
 
     memset(&g_fx_api_v2, 0, sizeof(g_fx_api_v2));
     g_fx_api_v2.api_version     = AUDIO_FX_API_VERSION_2;
@@ -448,3 +1762,44 @@ audio_fx_api_v2_t *move_audio_fx_init_v2(const host_api_v1_t *host) {
 
     return &g_fx_api_v2;
 }
+
+static audio_fx_api_v3_t g_fx_api_v3;
+
+audio_fx_api_v3_t *move_audio_fx_init_v3(const host_api_v1_t *host) {
+    g_host = host;
+    jc_select_kernel();
+
+    memset(&g_fx_api_v3, 0, sizeof(g_fx_api_v3));
+    g_fx_api_v3.api_version       = AUDIO_FX_API_VERSION_3;
+    g_fx_api_v3.create_instance   = v2_create_instance;
+    g_fx_api_v3.destroy_instance  = v2_destroy_instance;
+    g_fx_api_v3.process_block     = v2_process_block;
+    g_fx_api_v3.set_param         = v2_set_param;
+    g_fx_api_v3.get_param         = v2_get_param;
+    g_fx_api_v3.process_block_f32 = v3_process_block_f32;
+
+    jc_log("Junologue Chorus v3 plugin initialized");
+
+    return &g_fx_api_v3;
+}
+
+static audio_fx_api_v4_t g_fx_api_v4;
+
+audio_fx_api_v4_t *move_audio_fx_init_v4(const host_api_v1_t *host) {
+    g_host = host;
+    jc_select_kernel();
+
+    memset(&g_fx_api_v4, 0, sizeof(g_fx_api_v4));
+    g_fx_api_v4.api_version            = AUDIO_FX_API_VERSION_4;
+    g_fx_api_v4.create_instance        = v2_create_instance;
+    g_fx_api_v4.destroy_instance       = v2_destroy_instance;
+    g_fx_api_v4.process_block          = v2_process_block;
+    g_fx_api_v4.set_param              = v2_set_param;
+    g_fx_api_v4.get_param              = v2_get_param;
+    g_fx_api_v4.process_block_f32      = v3_process_block_f32;
+    g_fx_api_v4.process_blocks_batched = v4_process_blocks_batched;
+
+    jc_log("Junologue Chorus v4 plugin initialized");
+
+    return &g_fx_api_v4;
+}
@@ -0,0 +1,60 @@
+/*
+ * jc_test.h - shared helpers for the Junologue Chorus tests
+ *
+ * Each test is a standalone program that includes the plugin source
+ * (as jc-bench does, so internals are reachable), runs its checks and
+ * exits non-zero if any failed. scripts/run_tests.sh builds them with
+ * the plugin's release flags and runs them all. Include it after the
+ * plugin source.
+ */
+
+#ifndef JC_TEST_H
+#define JC_TEST_H
+
+#include <stdarg.h>
+#include <stdio.h>
+
+static int g_checks;
+static int g_failures;
+
+/* Record a failed check with a printf-style explanation; never aborts */
+#define CHECK(cond, ...)                                                    \
+    do {                                                                    \
+        g_checks++;                                                         \
+        if (!(cond)) test_fail(__FILE__, __LINE__, #cond, __VA_ARGS__);     \
+    } while (0)
+
+static void test_fail(const char *file, int line, const char *cond, const char *fmt, ...) {
+    va_list ap;
+    g_failures++;
+    fprintf(stderr, "%s:%d: check failed: %s: ", file, line, cond);
+    va_start(ap, fmt);
+    vfprintf(stderr, fmt, ap);
+    va_end(ap);
+    fputc('\n', stderr);
+}
+
+/* Print the summary line; returns main's exit code */
+static int test_finish(const char *name) {
+    printf("%-24s %s (%d checks, %d failed)\n", name,
+           g_failures ? "FAIL" : "ok", g_checks, g_failures);
+    return g_failures ? 1 : 0;
+}
+
+/* Deterministic noise, full scale / 4 */
+static inline void test_noise_s16(int16_t *buf, int frames, uint32_t *rng) {
+    for (int i = 0; i < frames * 2; i++) {
+        *rng = *rng * 1664525u + 1013904223u;
+        buf[i] = (int16_t)(((int32_t)(*rng >> 16) - 32768) / 4);
+    }
+}
+
+/*
+ * NaN/Inf test that survives -Ofast (-ffinite-math-only folds
+ * isfinite); same bit test the plugin uses
+ */
+static inline int test_finite(float x) {
+    return !jc_nonfinite(x);
+}
+
+#endif /* JC_TEST_H */
@@ -0,0 +1,182 @@
+/*
+ * arm_neon.h stand-in for x86 test builds
+ *
+ * Just the intrinsics jc_simd.h uses, written lane by lane from their
+ * Arm ARM definitions (saturation, rounding, FMIN/FMAX zero and NaN
+ * rules). With -D__ARM_NEON=1 -Itests/neon, run_tests.sh compiles the
+ * plugin's NEON branches on the host and runs test_simd on them. That
+ * tests the branches against this emulation only: a misreading of an
+ * instruction here would pass, and it says nothing about the real
+ * header or aarch64 code generation. Running the tests on the Move is
+ * the actual check. Never on an include path for a real build.
+ */
+
+#ifndef JC_TEST_ARM_NEON_H
+#define JC_TEST_ARM_NEON_H
+
+#if defined(__aarch64__) || defined(__arm__)
+#error "tests/neon/arm_neon.h is for host builds only; use the compiler's arm_neon.h"
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+typedef float   float32x4_t __attribute__((vector_size(16)));
+typedef int32_t int32x4_t   __attribute__((vector_size(16)));
+typedef int16_t int16x8_t   __attribute__((vector_size(16)));
+typedef int16_t int16x4_t   __attribute__((vector_size(8)));
+
+typedef struct { float32x4_t val[2]; } float32x4x2_t;
+typedef struct { int16x8_t val[2]; } int16x8x2_t;
+
+static inline int16_t neon_sat16(int64_t x) {
+    return (int16_t)(x > INT16_MAX ? INT16_MAX : x < INT16_MIN ? INT16_MIN : x);
+}
+
+static inline int32_t neon_sat32(int64_t x) {
+    return (int32_t)(x > INT32_MAX ? INT32_MAX : x < INT32_MIN ? INT32_MIN : x);
+}
+
+/* --- LD2/ST2 --- */
+
+static inline float32x4x2_t vld2q_f32(const float *p) {
+    float e[2][4];
+    float32x4x2_t v;
+    for (int i = 0; i < 4; i++) {
+        e[0][i] = p[2 * i];
+        e[1][i] = p[2 * i + 1];
+    }
+    memcpy(&v, e, sizeof(v));
+    return v;
+}
+
+static inline void vst2q_f32(float *p, float32x4x2_t v) {
+    for (int i = 0; i < 4; i++) {
+        p[2 * i] = v.val[0][i];
+        p[2 * i + 1] = v.val[1][i];
+    }
+}
+
+static inline int16x8x2_t vld2q_s16(const int16_t *p) {
+    int16_t e[2][8];
+    int16x8x2_t v;
+    for (int i = 0; i < 8; i++) {
+        e[0][i] = p[2 * i];
+        e[1][i] = p[2 * i + 1];
+    }
+    memcpy(&v, e, sizeof(v));
+    return v;
+}
+
+static inline void vst2q_s16(int16_t *p, int16x8x2_t v) {
+    for (int i = 0; i < 8; i++) {
+        p[2 * i] = v.val[0][i];
+        p[2 * i + 1] = v.val[1][i];
+    }
+}
+
+/* --- FMIN/FMAX: NaN in, NaN out; -0 below +0 --- */
+
+static inline float neon_fminmax(float a, float b, int max) {
+    if (a != a) return a;
+    if (b != b) return b;
+    if (a == 0.0f && b == 0.0f) {
+        uint32_t ua, ub;
+        memcpy(&ua, &a, sizeof(ua));
+        memcpy(&ub, &b, sizeof(ub));
+        return max ? ((ua & ub) >> 31 ? a : 0.0f) : ((ua | ub) >> 31 ? -0.0f : a);
+    }
+    return (a < b) ^ max ? a : b;
+}
+
+static inline float32x4_t vminq_f32(float32x4_t a, float32x4_t b) {
+    float32x4_t r = { 0 };
+    for (int i = 0; i < 4; i++) r[i] = neon_fminmax(a[i], b[i], 0);
+    return r;
+}
+
+static inline float32x4_t vmaxq_f32(float32x4_t a, float32x4_t b) {
+    float32x4_t r = { 0 };
+    for (int i = 0; i < 4; i++) r[i] = neon_fminmax(a[i], b[i], 1);
+    return r;
+}
+
+/* --- Halves, widen, narrow --- */
+
+static inline int16x4_t vget_low_s16(int16x8_t v) {
+    return (int16x4_t){ v[0], v[1], v[2], v[3] };
+}
+
+static inline int16x4_t vget_high_s16(int16x8_t v) {
+    return (int16x4_t){ v[4], v[5], v[6], v[7] };
+}
+
+static inline int16x8_t vcombine_s16(int16x4_t lo, int16x4_t hi) {
+    return (int16x8_t){ lo[0], lo[1], lo[2], lo[3], hi[0], hi[1], hi[2], hi[3] };
+}
+
+static inline int32x4_t vmovl_s16(int16x4_t v) {
+    return (int32x4_t){ v[0], v[1], v[2], v[3] };
+}
+
+/* SQXTN */
+static inline int16x4_t vqmovn_s32(int32x4_t v) {
+    int16x4_t r = { 0 };
+    for (int i = 0; i < 4; i++) r[i] = neon_sat16(v[i]);
+    return r;
+}
+
+/* SQRSHRN #n: round half up, shift, saturate, all at full precision */
+static inline int16x4_t vqrshrn_n_s32(int32x4_t v, int n) {
+    int16x4_t r = { 0 };
+    for (int i = 0; i < 4; i++)
+        r[i] = neon_sat16(((int64_t)v[i] + ((int64_t)1 << (n - 1))) >> n);
+    return r;
+}
+
+/* --- Saturating and halving arithmetic --- */
+
+/* SHADD */
+static inline int16x8_t vhaddq_s16(int16x8_t a, int16x8_t b) {
+    int16x8_t r = { 0 };
+    for (int i = 0; i < 8; i++) r[i] = (int16_t)(((int32_t)a[i] + b[i]) >> 1);
+    return r;
+}
+
+/* SQADD */
+static inline int32x4_t vqaddq_s32(int32x4_t a, int32x4_t b) {
+    int32x4_t r = { 0 };
+    for (int i = 0; i < 4; i++) r[i] = neon_sat32((int64_t)a[i] + b[i]);
+    return r;
+}
+
+/* SQDMULH: high half of the doubled product, saturated */
+static inline int32x4_t vqdmulhq_s32(int32x4_t a, int32x4_t b) {
+    int32x4_t r = { 0 };
+    for (int i = 0; i < 4; i++) {
+        __int128 p = (__int128)2 * a[i] * b[i];
+        r[i] = neon_sat32((int64_t)(p >> 32));
+    }
+    return r;
+}
+
+static inline int32x4_t vqdmulhq_n_s32(int32x4_t a, int32_t b) {
+    int32x4_t r = { 0 };
+    for (int i = 0; i < 4; i++) {
+        __int128 p = (__int128)2 * a[i] * b;
+        r[i] = neon_sat32((int64_t)(p >> 32));
+    }
+    return r;
+}
+
+/* SQRDMULH: the same, rounded by adding 2^31 before the high half */
+static inline int32x4_t vqrdmulhq_s32(int32x4_t a, int32x4_t b) {
+    int32x4_t r = { 0 };
+    for (int i = 0; i < 4; i++) {
+        __int128 p = (__int128)2 * a[i] * b[i] + ((__int128)1 << 31);
+        r[i] = neon_sat32((int64_t)(p >> 32));
+    }
+    return r;
+}
+
+#endif /* JC_TEST_ARM_NEON_H */
@@ -0,0 +1,86 @@
+/*
+ * process_blocks_batched against process_block: two identical sets of
+ * instances, one run through the batched entry point and one serially,
+ * must agree to 1 LSB. The set mixes batchable instances (which share
+ * the lane kernel) with ones that are not (bbd, fixed engine, half
+ * rate, NULL), settings change mid-run so lanes drop out while they
+ * ramp, and one input goes silent so its instance idles.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+#define NUM_INST   7
+#define NUM_BLOCKS 400
+#define FRAMES     200          /* not a multiple of JC_CHUNK */
+
+static const char *SETUP[NUM_INST][3][2] = {
+    { { "mode", "I" },    { "mix", "0.5" },  { NULL, NULL } },
+    { { "mode", "II" },   { "mix", "1" },    { "brightness", "0.3" } },
+    { { "mode", "I+II" }, { "mix", "0.7" },  { NULL, NULL } },
+    { { "mode", "I" },    { "model", "bbd" }, { NULL, NULL } },
+    { { "mode", "I+II" }, { "mix", "0.4" },  { "brightness", "0" } },
+    { { "mode", "II" },   { "engine", "fixed" }, { NULL, NULL } },
+    { { "mode", "I" },    { "half_rate", "on" }, { NULL, NULL } },
+};
+
+int main(void) {
+    audio_fx_api_v4_t *api = move_audio_fx_init_v4(NULL);
+    void *batched[NUM_INST + 1], *serial[NUM_INST + 1];
+    static int16_t buf_b[NUM_INST + 1][FRAMES * 2], buf_s[NUM_INST + 1][FRAMES * 2];
+    int16_t *io_b[NUM_INST + 1];
+    uint32_t rng = 3;
+    int worst = 0, lanes_used = 0;
+
+    CHECK(api && api->process_blocks_batched, "no v4 entry point");
+    for (int j = 0; j < NUM_INST; j++) {
+        batched[j] = api->create_instance(".", NULL);
+        serial[j] = api->create_instance(".", NULL);
+        for (int p = 0; p < 3 && SETUP[j][p][0]; p++) {
+            api->set_param(batched[j], SETUP[j][p][0], SETUP[j][p][1]);
+            api->set_param(serial[j], SETUP[j][p][0], SETUP[j][p][1]);
+        }
+        io_b[j] = buf_b[j];
+    }
+    batched[NUM_INST] = serial[NUM_INST] = NULL;
+    io_b[NUM_INST] = buf_b[NUM_INST];
+
+    for (int b = 0; b < NUM_BLOCKS; b++) {
+        if (b == NUM_BLOCKS / 3 || b == NUM_BLOCKS * 2 / 3) {
+            const char *mix = b == NUM_BLOCKS / 3 ? "0.9" : "0.2";
+            for (int j = 0; j < 3; j++) {
+                api->set_param(batched[j], "mix", mix);
+                api->set_param(serial[j], "mix", mix);
+            }
+        }
+        for (int j = 0; j <= NUM_INST; j++) {
+            test_noise_s16(buf_b[j], FRAMES, &rng);
+            if (j == 2 && b >= NUM_BLOCKS / 2) memset(buf_b[j], 0, sizeof(buf_b[j]));
+            memcpy(buf_s[j], buf_b[j], sizeof(buf_b[j]));
+        }
+
+        api->process_blocks_batched(batched, io_b, NUM_INST + 1, FRAMES);
+        for (int j = 0; j < NUM_INST; j++)
+            api->process_block(serial[j], buf_s[j], FRAMES);
+
+        for (int j = 0; j < NUM_INST; j++)
+            for (int i = 0; i < FRAMES * 2; i++) {
+                int d = abs(buf_b[j][i] - buf_s[j][i]);
+                if (d > worst) worst = d;
+            }
+        int k = 0;
+        for (int j = 0; j < NUM_INST; j++)
+            k += jc_batchable((jc_instance_t *)batched[j]);
+        if (k >= JC_LANES_MIN) lanes_used++;
+    }
+
+    CHECK(worst <= 1, "batched differs from process_block by %d LSB", worst);
+    CHECK(lanes_used > NUM_BLOCKS / 2, "lane kernel ran on only %d of %d blocks",
+          lanes_used, NUM_BLOCKS);
+    for (int j = 0; j < NUM_INST; j++) {
+        api->destroy_instance(batched[j]);
+        api->destroy_instance(serial[j]);
+    }
+    printf("(worst difference %d LSB, lane kernel on %d blocks)\n", worst, lanes_used);
+    return test_finish("batched");
+}
@@ -0,0 +1,90 @@
+/*
+ * BBD model with its input and output filter banks: a steady tone
+ * through one line at a fixed clock comes out at the gain of the two
+ * 4th-order Butterworth lowpasses, and the impulse response delay
+ * matches the clock setting, at 44.1, 48 and 96 kHz.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+static const int RATES[] = { 44100, 48000, 96000 };
+#define NUM_RATES ((int)(sizeof(RATES) / sizeof(RATES[0])))
+
+/* |H(f)| of one Butterworth bank */
+static double butter_gain(double hz) {
+    return 1.0 / sqrt(1.0 + pow(hz / BBD_FILTER_HZ, 2.0 * 2 * BBD_POLES));
+}
+
+/* Output/input RMS of a sine through one line, after a settling second */
+static double tone_gain(const bbd_filter_t *f, double rate, double hz, float delay) {
+    static bbd_line_t line;
+    bbd_input_t in;
+    double num = 0.0, den = 0.0;
+
+    float zero = 0.0f, ticks, span;
+    bbd_clock_block(&zero, delay, 0.0f, &ticks, &span, 1);
+    memset(&line, 0, sizeof(line));
+    memset(&in, 0, sizeof(in));
+    for (int i = 0; i < (int)(2 * rate); i++) {
+        float x = (float)sin(2.0 * M_PI * hz * i / rate);
+        float y = bbd_process(&line, f, &in, ticks, span);
+        bbd_input_push(f, &in, x);
+        if (i >= (int)rate) {
+            num += (double)y * y;
+            den += (double)x * x;
+        }
+    }
+    return sqrt(num / den);
+}
+
+int main(void) {
+    static bbd_filter_t f;
+
+    for (int r = 0; r < NUM_RATES; r++) {
+        const double rate = RATES[r];
+        const float delay = (float)(DELAY_MIN_SEC * rate);
+        bbd_filter_init(&f, (float)rate);
+
+        /* DC and passband within 0.1 dB, 15 kHz down by both banks */
+        double g0 = tone_gain(&f, rate, 50.0, delay);
+        double g1 = tone_gain(&f, rate, 1000.0, delay);
+        double g15 = tone_gain(&f, rate, 15000.0, delay);
+        CHECK(fabs(20.0 * log10(g0)) < 0.1, "%d Hz: 50 Hz gain %.3f dB", RATES[r], 20.0 * log10(g0));
+        CHECK(fabs(20.0 * log10(g1 / (butter_gain(1000.0) * butter_gain(1000.0)))) < 0.1,
+              "%d Hz: 1 kHz gain %.3f dB", RATES[r], 20.0 * log10(g1));
+        CHECK(g15 < 0.1 && g15 > 0.5 * butter_gain(15000.0) * butter_gain(15000.0),
+              "%d Hz: 15 kHz gain %.1f dB, want about %.1f dB", RATES[r], 20.0 * log10(g15),
+              40.0 * log10(butter_gain(15000.0)));
+
+        /* Impulse centroid: the clock delay plus the two banks' group delay */
+        static bbd_line_t line;
+        bbd_input_t in;
+        double sum = 0.0, moment = 0.0;
+        float zero = 0.0f, ticks, span;
+        bbd_clock_block(&zero, delay, 0.0f, &ticks, &span, 1);
+        memset(&line, 0, sizeof(line));
+        memset(&in, 0, sizeof(in));
+        for (int i = 0; i < (int)(0.02 * rate); i++) {
+            float y = bbd_process(&line, &f, &in, ticks, span);
+            bbd_input_push(&f, &in, i == 0 ? 1.0f : 0.0f);
+            sum += y;
+            moment += y * (double)i;
+        }
+        /* Butterworth group delay at DC is sum -Re(p) / |p|^2; the hold adds half a tick */
+        double gd = 0.0;
+        for (int k = 0; k < 2 * BBD_POLES; k++)
+            gd += sin(M_PI * (2 * k + 1) / (4.0 * BBD_POLES)) / (2.0 * M_PI * BBD_FILTER_HZ);
+        double want = DELAY_MIN_SEC * (1.0 + 0.5 / BBD_STAGES) + 2.0 * gd;
+        CHECK(fabs(sum - 1.0) < 1e-3, "%d Hz: impulse area %.5f", RATES[r], sum);
+        CHECK(fabs(moment / sum / rate - want) < 0.25 / rate,
+              "%d Hz: impulse delay %.4f ms, want %.4f ms", RATES[r],
+              moment / sum / rate * 1e3, want * 1e3);
+
+        /* The tail estimate covers the banks' ring-down */
+        int decay = bbd_filter_decay_frames(&f, JC_SILENCE);
+        CHECK(decay > 0 && decay < (int)(0.002 * rate), "%d Hz: filter decay %d frames", RATES[r], decay);
+    }
+
+    return test_finish("bbd");
+}
@@ -0,0 +1,219 @@
+/*
+ * Templated tap stages (jc_core.hpp). Every kernel's table binds the
+ * Move's ring rates to their own rows and any other rate to the
+ * run-time-rate one. A specialized row, with its delays built in, must
+ * render what the run-time row renders from the delays the plugin
+ * computes: Q15 stages bit for bit, float ones within CORE_TOL (the
+ * compiler may fold the constants into a different last bit). And a
+ * mode's stage, with its gains and LFOs taken from MODE_GAIN at
+ * compile time, must match the ramp stage running on those gains.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+#define CHUNKS   64
+#define CORE_TOL 1e-6f
+
+static const char *const STAGE_NAMES[4] = { "I", "I+II", "II", "ramp" };
+
+typedef struct {
+    lfo_t     lfo1, lfo2;
+    jc_ramp_t gain_a, gain_b;
+    float     ap_y[4];
+    float     wet_l[JC_CHUNK] JC_ALIGNED;
+    float     wet_r[JC_CHUNK] JC_ALIGNED;
+    int32_t   q_wet_l[JC_CHUNK] JC_ALIGNED;
+    int32_t   q_wet_r[JC_CHUNK] JC_ALIGNED;
+    jc_core_taps_t t;
+} taps_t;
+
+/*
+ * Fresh stage state at ring rate rate, delays as jc_set_ring_rate sets
+ * them. Gains start at mode m's; with ramp_to >= 0 they move to that
+ * mode's over most of the run.
+ */
+static void taps_init(taps_t *s, float rate, int m, int ramp_to) {
+    memset(s, 0, sizeof(*s));
+    lfo_init(&s->lfo1, LFO_RATE_MHZ[0], (uint32_t)rate);
+    lfo_init(&s->lfo2, LFO_RATE_MHZ[1], (uint32_t)rate);
+    jc_ramp_reset(&s->gain_a, MODE_GAIN[m][0]);
+    jc_ramp_reset(&s->gain_b, MODE_GAIN[m][1]);
+    if (ramp_to >= 0) {
+        jc_ramp_set(&s->gain_a, MODE_GAIN[ramp_to][0], CHUNKS * JC_CHUNK * 3 / 4);
+        jc_ramp_set(&s->gain_b, MODE_GAIN[ramp_to][1], CHUNKS * JC_CHUNK * 3 / 4);
+    }
+
+    jc_core_taps_t t = {
+        &s->lfo1, &s->lfo2, &s->gain_a, &s->gain_b, s->ap_y,
+        s->wet_l, s->wet_r, s->q_wet_l, s->q_wet_r,
+        DELAY_MIN_SEC * rate, (DELAY_MAX_SEC - DELAY_MIN_SEC) * rate, 0, 0
+    };
+    t.q_dt_min = (int32_t)lrintf(t.dt_min * 65536.0f);
+    t.q_dt_rng = (int32_t)lrintf(t.dt_rng * 65536.0f);
+    s->t = t;
+}
+
+typedef struct {
+    delay_line_t ring;      /* float and Q15 rings fed the same noise */
+    int16_t q15[JC_CHUNK];
+    float   f32[JC_CHUNK];
+    uint32_t rng;
+} input_t;
+
+static void input_init(input_t *in, float rate) {
+    memset(in, 0, sizeof(*in));
+    delay_init(&in->ring, (int)(DELAY_MAX_SEC * rate) + 3);
+    delay_init_q15(&in->ring);
+    in->rng = 5;
+}
+
+/* The next chunk into both rings; returns the ring index of its frame 0 */
+static int input_next(input_t *in) {
+    int16_t st[JC_CHUNK * 2];
+    test_noise_s16(st, JC_CHUNK, &in->rng);
+    for (int i = 0; i < JC_CHUNK; i++) {
+        in->q15[i] = st[2 * i];
+        in->f32[i] = st[2 * i] / 32768.0f;
+    }
+    int pos = in->ring.write_pos;
+    delay_write_block(&in->ring, in->f32, JC_CHUNK);
+    in->ring.write_pos = pos;
+    delay_write_block_q15(&in->ring, in->q15, JC_CHUNK);
+    return pos;
+}
+
+static float max_diff(const float *a, const float *b, int n) {
+    float d = 0.0f;
+    for (int i = 0; i < n; i++) d = fmaxf(d, fabsf(a[i] - b[i]));
+    return d;
+}
+
+static int count_diff_q(const int32_t *a, const int32_t *b, int n) {
+    int d = 0;
+    for (int i = 0; i < n; i++) d += a[i] != b[i];
+    return d;
+}
+
+/* Stage fa on state a against fb on state b, same input, float taps */
+static float run_pair(jc_core_tap_fn fa, taps_t *a, jc_core_tap_fn fb, taps_t *b,
+                      float rate) {
+    input_t in;
+    float worst = 0.0f;
+    input_init(&in, rate);
+    for (int c = 0; c < CHUNKS; c++) {
+        int pos = input_next(&in);
+        fa(&a->t, delay_block_base(&in.ring, pos), JC_CHUNK);
+        fb(&b->t, delay_block_base(&in.ring, pos), JC_CHUNK);
+        worst = fmaxf(worst, max_diff(a->wet_l, b->wet_l, JC_CHUNK));
+        worst = fmaxf(worst, max_diff(a->wet_r, b->wet_r, JC_CHUNK));
+    }
+    delay_free(&in.ring);
+    return worst;
+}
+
+static int run_pair_q15(jc_core_tap_q15_fn fa, taps_t *a, jc_core_tap_q15_fn fb, taps_t *b,
+                        float rate) {
+    input_t in;
+    int diff = 0;
+    input_init(&in, rate);
+    for (int c = 0; c < CHUNKS; c++) {
+        int pos = input_next(&in);
+        fa(&a->t, delay_block_base_q15(&in.ring, pos), JC_CHUNK);
+        fb(&b->t, delay_block_base_q15(&in.ring, pos), JC_CHUNK);
+        diff += count_diff_q(a->q_wet_l, b->q_wet_l, JC_CHUNK);
+        diff += count_diff_q(a->q_wet_r, b->q_wet_r, JC_CHUNK);
+    }
+    delay_free(&in.ring);
+    return diff;
+}
+
+/* A specialized row against the run-time one at its rate */
+static void check_row(const char *kern, const jc_core_row_t *row, const jc_core_row_t *any) {
+    static taps_t a, b;
+    const float rate = row->rate;
+
+    for (int q = 0; q < 3; q++)
+        for (int s = 0; s < 4; s++) {
+            int m = s == JC_TAP_RAMP ? 0 : s;
+            int to = s == JC_TAP_RAMP ? 1 : -1;
+            taps_init(&a, rate, m, to);
+            taps_init(&b, rate, m, to);
+            float d = run_pair(row->taps[q][s], &a, any->taps[q][s], &b, rate);
+            CHECK(d <= CORE_TOL, "%s: %.0f Hz row, quality %d, %s: %g off the run-time row",
+                  kern, rate, q, STAGE_NAMES[s], d);
+        }
+
+    for (int s = 0; s < 4; s++) {
+        int m = s == JC_TAP_RAMP ? 0 : s;
+        int to = s == JC_TAP_RAMP ? 1 : -1;
+        taps_init(&a, rate, m, to);
+        taps_init(&b, rate, m, to);
+        int d = run_pair_q15(row->taps_q15[s], &a, any->taps_q15[s], &b, rate);
+        CHECK(d == 0, "%s: %.0f Hz row, Q15 %s: %d samples off the run-time row",
+              kern, rate, STAGE_NAMES[s], d);
+    }
+}
+
+/* Each mode's stage against the ramp stage settled on that mode's gains */
+static void check_gains(const char *kern, const jc_core_row_t *row, float rate) {
+    static taps_t a, b;
+
+    for (int q = 0; q < 3; q++)
+        for (int m = 0; m < 3; m++) {
+            taps_init(&a, rate, m, -1);
+            taps_init(&b, rate, m, -1);
+            float d = run_pair(row->taps[q][m], &a, row->taps[q][JC_TAP_RAMP], &b, rate);
+            CHECK(d <= CORE_TOL, "%s: %.0f Hz, quality %d, mode %s: %g off the ramp stage",
+                  kern, rate, q, STAGE_NAMES[m], d);
+            CHECK(a.lfo1.phase == b.lfo1.phase && a.lfo2.phase == b.lfo2.phase,
+                  "%s: mode %s: LFO phase differs from the ramp stage", kern, STAGE_NAMES[m]);
+        }
+
+    for (int m = 0; m < 3; m++) {
+        taps_init(&a, rate, m, -1);
+        taps_init(&b, rate, m, -1);
+        int d = run_pair_q15(row->taps_q15[m], &a, row->taps_q15[JC_TAP_RAMP], &b, rate);
+        CHECK(d == 0, "%s: %.0f Hz, Q15 mode %s: %d samples off the ramp stage",
+              kern, rate, STAGE_NAMES[m], d);
+    }
+}
+
+int main(void) {
+    move_audio_fx_init_v4(NULL);
+
+    for (int k = 0; k < JC_NUM_KERNELS; k++) {
+        const jc_kernel_t *kern = JC_KERNELS[k];
+        if (!kern->supported()) {
+            printf("(%s: not supported here, skipped)\n", kern->name);
+            continue;
+        }
+
+        const jc_core_kernel_t *core = kern->core;
+        const jc_core_row_t *any = &core->rows[core->num_rows - 1];
+        const jc_core_row_t *full = jc_core_bind(core, (float)MOVE_SAMPLE_RATE);
+        const jc_core_row_t *half = jc_core_bind(core, MOVE_SAMPLE_RATE * 0.5f);
+
+        CHECK(any->rate == 0.0f, "%s: last row is for %.0f Hz, not any rate",
+              kern->name, any->rate);
+        CHECK(full->rate == (float)MOVE_SAMPLE_RATE && half->rate == MOVE_SAMPLE_RATE * 0.5f,
+              "%s: Move rates bound to the %.0f and %.0f Hz rows",
+              kern->name, full->rate, half->rate);
+        CHECK(jc_core_bind(core, 48000.0f) == any && jc_core_bind(core, 22050.5f) == any,
+              "%s: other rates not bound to the run-time row", kern->name);
+
+        check_row(kern->name, full, any);
+        check_row(kern->name, half, any);
+        check_gains(kern->name, full, full->rate);
+        check_gains(kern->name, any, 48000.0f);
+    }
+
+    /* create_instance binds the selected kernel's rows for the host rate */
+    jc_instance_t *inst = (jc_instance_t *)g_fx_api_v4.create_instance(".", NULL);
+    CHECK(inst->core_row[0] == jc_core_bind(g_kernel->core, inst->sample_rate) &&
+          inst->core_row[1] == jc_core_bind(g_kernel->core, inst->sample_rate * 0.5f),
+          "instance not bound to the selected kernel's rows");
+    g_fx_api_v4.destroy_instance(inst);
+
+    return test_finish("core");
+}
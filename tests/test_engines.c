@@ -0,0 +1,94 @@
+/*
+ * Golden-output tolerance for the fixed-point engine: the float engine
+ * is the reference, and on the same int16 input the Q15 engine must
+ * stay within ENGINE_TOL_LSB of it in every mode, at mix 0.5 and 1 and
+ * across brightness, on a -6 dBFS sine and on noise, including while
+ * parameters ramp. Also checks the fixed engine really ran, that the
+ * float instance never allocated its Q15 ring, and that the soft-limit
+ * polynomial stays within half an LSB of soft_limit().
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+#define ENGINE_TOL_LSB     3    /* README: "within 3 LSB of float" */
+#define SOFT_LIMIT_TOL_LSB 0.5
+#define RUN_BLOCKS         400
+
+static void run(const char *mode, const char *mix, const char *bright, int noise) {
+    void *inst[2];
+    int16_t buf[2][JC_CHUNK * 2];
+    uint32_t rng = 17;
+    int worst = 0;
+    long diffs = 0;
+
+    for (int e = 0; e < 2; e++) {
+        inst[e] = g_fx_api_v2.create_instance(".", NULL);
+        g_fx_api_v2.set_param(inst[e], "mode", mode);
+        g_fx_api_v2.set_param(inst[e], "mix", mix);
+        g_fx_api_v2.set_param(inst[e], "brightness", bright);
+        g_fx_api_v2.set_param(inst[e], "engine", e == JC_ENGINE_FIXED ? "fixed" : "float");
+    }
+
+    for (int blk = 0; blk < RUN_BLOCKS; blk++) {
+        if (noise) {
+            test_noise_s16(buf[0], JC_CHUNK, &rng);
+        } else {
+            for (int i = 0; i < JC_CHUNK; i++) {
+                double t = (double)(blk * JC_CHUNK + i) / DEFAULT_SAMPLE_RATE;
+                int16_t v = (int16_t)lrint(16384.0 * sin(2.0 * M_PI * 1000.0 * t));
+                buf[0][i * 2] = buf[0][i * 2 + 1] = v;
+            }
+        }
+        memcpy(buf[1], buf[0], sizeof(buf[0]));
+
+        /* Halfway through, move mix and brightness so both engines ramp */
+        if (blk == RUN_BLOCKS / 2)
+            for (int e = 0; e < 2; e++) {
+                g_fx_api_v2.set_param(inst[e], "mix", "0.8");
+                g_fx_api_v2.set_param(inst[e], "brightness", "0.2");
+            }
+
+        for (int e = 0; e < 2; e++) g_fx_api_v2.process_block(inst[e], buf[e], JC_CHUNK);
+        for (int i = 0; i < JC_CHUNK * 2; i++) {
+            int d = abs(buf[1][i] - buf[0][i]);
+            if (d > worst) worst = d;
+            diffs += d != 0;
+        }
+    }
+
+    CHECK(((jc_instance_t *)inst[JC_ENGINE_FIXED])->engine_on == JC_ENGINE_FIXED,
+          "mode %s mix %s: fixed engine not running", mode, mix);
+    CHECK(((jc_instance_t *)inst[JC_ENGINE_FLOAT])->delay.qbuf == NULL,
+          "mode %s mix %s: float instance allocated the Q15 ring", mode, mix);
+    CHECK(worst <= ENGINE_TOL_LSB, "mode %s, mix %s, brightness %s, %s: fixed is %d LSB from float",
+          mode, mix, bright, noise ? "noise" : "sine", worst);
+    if (noise && strcmp(mode, "I+II") == 0 && strcmp(mix, "1") == 0 && strcmp(bright, "1") == 0)
+        printf("(mode I+II, mix 1, noise: worst %d LSB, %ld of %d samples differ)\n",
+               worst, diffs, RUN_BLOCKS * JC_CHUNK * 2);
+
+    for (int e = 0; e < 2; e++) g_fx_api_v2.destroy_instance(inst[e]);
+}
+
+int main(void) {
+    static const char *modes[] = { "I", "I+II", "II" };
+    static const char *mixes[] = { "0.5", "1" };
+    static const char *brights[] = { "1", "0.5", "0" };
+
+    double sl_err = 0.0;
+    for (int k = INT16_MIN; k <= INT16_MAX; k++) {
+        double x = k / 32768.0;
+        double want = 32767.0 * x * (27.0 + x * x) / (27.0 + 9.0 * x * x);
+        sl_err = fmax(sl_err, fabs(soft_limit_q30(k) * 0x1p-15 - want));
+    }
+    CHECK(sl_err <= SOFT_LIMIT_TOL_LSB, "soft_limit_q30 is %.3f LSB from soft_limit", sl_err);
+
+    move_audio_fx_init_v2(NULL);
+    for (int m = 0; m < 3; m++)
+        for (int x = 0; x < 2; x++)
+            for (int b = 0; b < 3; b++)
+                for (int noise = 0; noise < 2; noise++)
+                    run(modes[m], mixes[x], brights[b], noise);
+
+    return test_finish("engines");
+}
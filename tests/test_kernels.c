@@ -0,0 +1,184 @@
+/*
+ * Process kernel equivalence: every kernel this CPU supports renders
+ * the same input as the scalar reference, through process_block (both
+ * engines, every model and interpolation tier, full and half rate, all
+ * modes, with a parameter change halfway), process_block_f32 and the
+ * batched lane kernel. The fixed engine must match bit for bit. Float
+ * output may differ by KERNEL_TOL_LSB (KERNEL_TOL_F32 unclamped): FMA
+ * contraction changes the last bit of a float, and the recursive
+ * filters carry that on. With Thiran taps that last bit can also move
+ * an integer-part jump of the delay by a frame, and the allpass
+ * transient then differs, so up to one sample in THIRAN_JUMP_RATIO may
+ * exceed the tolerance there. Kernels the CPU lacks are listed as skipped;
+ * the armv8.2 one needs an FP16 and dot product core, which the Move's
+ * Cortex-A72 is not.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+#define RUN_BLOCKS     200
+#define KERNEL_TOL_LSB 1
+#define KERNEL_TOL_F32 1e-4f
+#define THIRAN_JUMP_RATIO 1000
+
+typedef struct {
+    const char *mode, *model, *quality, *half_rate, *engine;
+} config_t;
+
+static const config_t CONFIGS[] = {
+    { "I",    "ideal", "linear",  "off", "float" },
+    { "I+II", "ideal", "linear",  "off", "float" },
+    { "II",   "ideal", "linear",  "off", "float" },
+    { "I+II", "ideal", "hermite", "off", "float" },
+    { "I+II", "ideal", "thiran",  "off", "float" },
+    { "I+II", "ideal", "linear",  "on",  "float" },
+    { "I+II", "bbd",   "linear",  "off", "float" },
+    { "I",    "ideal", "linear",  "off", "fixed" },
+    { "I+II", "ideal", "linear",  "off", "fixed" },
+    { "II",   "ideal", "linear",  "off", "fixed" },
+};
+#define NUM_CONFIGS ((int)(sizeof(CONFIGS) / sizeof(CONFIGS[0])))
+
+static void *create_on(const jc_kernel_t *kern, const config_t *c) {
+    void *inst = g_fx_api_v4.create_instance(".", NULL);
+    g_fx_api_v4.set_param(inst, "mode", c->mode);
+    g_fx_api_v4.set_param(inst, "model", c->model);
+    g_fx_api_v4.set_param(inst, "quality", c->quality);
+    g_fx_api_v4.set_param(inst, "half_rate", c->half_rate);
+    g_fx_api_v4.set_param(inst, "engine", c->engine);
+    g_fx_api_v4.set_param(inst, "mix", "0.7");
+
+    /* Swap the kernel and republish its tap stages, as jc-bench does */
+    jc_bind_kernel((jc_instance_t *)inst, kern);
+    jc_update_params((jc_instance_t *)inst);
+    return inst;
+}
+
+/* Halfway through, move mix and brightness so the ramp stages run */
+static void move_params(void *inst, int blk) {
+    if (blk != RUN_BLOCKS / 2) return;
+    g_fx_api_v4.set_param(inst, "mix", "1");
+    g_fx_api_v4.set_param(inst, "brightness", "0.3");
+}
+
+/* int16 output of one config on kern, for RUN_BLOCKS chunks */
+static void render_s16(const jc_kernel_t *kern, const config_t *c, int16_t *out) {
+    void *inst = create_on(kern, c);
+    uint32_t rng = 11;
+    for (int blk = 0; blk < RUN_BLOCKS; blk++) {
+        int16_t *io = out + blk * JC_CHUNK * 2;
+        test_noise_s16(io, JC_CHUNK, &rng);
+        move_params(inst, blk);
+        g_fx_api_v4.process_block(inst, io, JC_CHUNK);
+    }
+    g_fx_api_v4.destroy_instance(inst);
+}
+
+static void render_f32(const jc_kernel_t *kern, const config_t *c, float *out) {
+    void *inst = create_on(kern, c);
+    uint32_t rng = 11;
+    int16_t s16[JC_CHUNK * 2];
+    for (int blk = 0; blk < RUN_BLOCKS; blk++) {
+        float *io = out + blk * JC_CHUNK * 2;
+        test_noise_s16(s16, JC_CHUNK, &rng);
+        for (int i = 0; i < JC_CHUNK * 2; i++) io[i] = s16[i] / 32768.0f;
+        move_params(inst, blk);
+        g_fx_api_v4.process_block_f32(inst, io, JC_CHUNK);
+    }
+    g_fx_api_v4.destroy_instance(inst);
+}
+
+/* Four steady instances through process_blocks_batched, kern selected */
+static void render_lanes(const jc_kernel_t *kern, int16_t *out) {
+    static const char *modes[4] = { "I", "I+II", "II", "I+II" };
+    const jc_kernel_t *selected = g_kernel;
+    void *inst[4];
+    int16_t *io[4];
+    uint32_t rng = 23;
+
+    g_kernel = kern;
+    for (int l = 0; l < 4; l++) {
+        config_t c = CONFIGS[0];
+        c.mode = modes[l];
+        inst[l] = create_on(kern, &c);
+    }
+    for (int blk = 0; blk < RUN_BLOCKS; blk++)
+        for (int l = 0; l < 4; l++) {
+            io[l] = out + ((size_t)l * RUN_BLOCKS + blk) * JC_CHUNK * 2;
+            test_noise_s16(io[l], JC_CHUNK, &rng);
+        }
+    for (int blk = 0; blk < RUN_BLOCKS; blk++) {
+        for (int l = 0; l < 4; l++) io[l] = out + ((size_t)l * RUN_BLOCKS + blk) * JC_CHUNK * 2;
+        g_fx_api_v4.process_blocks_batched(inst, io, 4, JC_CHUNK);
+    }
+    for (int l = 0; l < 4; l++) g_fx_api_v4.destroy_instance(inst[l]);
+    g_kernel = selected;
+}
+
+/* Samples of b more than tol from a */
+static int over_s16(const int16_t *a, const int16_t *b, int n, int tol) {
+    int over = 0;
+    for (int i = 0; i < n; i++) over += abs(a[i] - b[i]) > tol;
+    return over;
+}
+
+static int over_f32(const float *a, const float *b, int n, float tol) {
+    int over = 0;
+    for (int i = 0; i < n; i++) over += fabsf(a[i] - b[i]) > tol;
+    return over;
+}
+
+int main(void) {
+    const int n = RUN_BLOCKS * JC_CHUNK * 2;
+    int16_t *ref = malloc(sizeof(int16_t) * n * 4);
+    int16_t *out = malloc(sizeof(int16_t) * n * 4);
+    float *fref = malloc(sizeof(float) * n);
+    float *fout = malloc(sizeof(float) * n);
+    int compared = 0;
+
+    move_audio_fx_init_v4(NULL);
+
+    for (int k = 0; k < JC_NUM_KERNELS; k++) {
+        const jc_kernel_t *kern = JC_KERNELS[k];
+        if (kern == &JC_KERNEL_scalar) continue;
+        if (!kern->supported()) {
+            printf("(%s: not supported here, skipped)\n", kern->name);
+            continue;
+        }
+        compared++;
+
+        for (int c = 0; c < NUM_CONFIGS; c++) {
+            const config_t *cf = &CONFIGS[c];
+            const int exact = strcmp(cf->engine, "fixed") == 0;
+            const int allowed = strcmp(cf->quality, "thiran") == 0 ? n / THIRAN_JUMP_RATIO : 0;
+            render_s16(&JC_KERNEL_scalar, cf, ref);
+            render_s16(kern, cf, out);
+            int over = over_s16(ref, out, n, exact ? 0 : KERNEL_TOL_LSB);
+            CHECK(over <= allowed,
+                  "%s: mode %s, %s/%s, half_rate %s, %s engine: %d samples off scalar",
+                  kern->name, cf->mode, cf->model, cf->quality, cf->half_rate, cf->engine,
+                  over);
+            if (exact) continue;
+
+            render_f32(&JC_KERNEL_scalar, cf, fref);
+            render_f32(kern, cf, fout);
+            over = over_f32(fref, fout, n, KERNEL_TOL_F32);
+            CHECK(over <= allowed, "%s: mode %s, %s/%s, half_rate %s, f32: %d samples off scalar",
+                  kern->name, cf->mode, cf->model, cf->quality, cf->half_rate, over);
+        }
+
+        render_lanes(&JC_KERNEL_scalar, ref);
+        render_lanes(kern, out);
+        int over = over_s16(ref, out, n * 4, KERNEL_TOL_LSB);
+        CHECK(over == 0, "%s: batched lanes: %d samples off scalar", kern->name, over);
+        printf("(%s: %d configs and batched lanes against scalar)\n", kern->name, NUM_CONFIGS);
+    }
+    CHECK(compared > 0, "no kernel besides scalar to compare");
+
+    free(ref);
+    free(out);
+    free(fref);
+    free(fout);
+    return test_finish("kernels");
+}
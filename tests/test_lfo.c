@@ -0,0 +1,161 @@
+/*
+ * LFO exactness. lfo_fill and lfo_fill_q31 must give the same values
+ * as stepping lfo_advance one tick at a time, from any state and at
+ * any block length; a simulated 24-hour run at 44.1 kHz in random
+ * block lengths must match the exact phase t * f * 2^32 / fs at every
+ * block end, with every cycle starting on the sample the rates 0.513
+ * and 0.863 Hz put it on; and the whole plugin must not depend on how
+ * the host splits the stream into blocks.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+#define DAY_SEC 86400L
+
+static uint32_t lcg(uint32_t *rng) {
+    *rng = *rng * 1664525u + 1013904223u;
+    return *rng;
+}
+
+/* Exact phase and remainder after t ticks from phase 0 */
+static void exact_phase(uint64_t t, uint32_t mhz, uint32_t rate, uint32_t *ph, uint32_t *rem) {
+    uint64_t den = (uint64_t)rate * 1000u;
+    uint64_t b = (t * mhz) % den;       /* whole cycles drop out mod 2^32 */
+    *ph = (uint32_t)((b << 32) / den);
+    *rem = (uint32_t)((b << 32) % den);
+}
+
+/* Fill vs one tick at a time, from random states */
+static void check_fill(uint32_t rate, uint32_t decim) {
+    static float v[JC_CHUNK];
+    static int32_t u[JC_CHUNK];
+    uint32_t rng = rate + decim;
+    int bad = 0;
+
+    for (int k = 0; k < 2; k++) {
+        lfo_t a, b;
+        lfo_init(&a, LFO_RATE_MHZ[k], rate);
+        lfo_set_rate(&a, LFO_RATE_MHZ[k], rate, decim);
+        for (int blk = 0; blk < 4000; blk++) {
+            if (blk % 100 == 0) {
+                a.phase = lcg(&rng);
+                a.rem = lcg(&rng) % a.den;
+            }
+            int n = 1 + (int)(lcg(&rng) % JC_CHUNK);
+            b = a;
+            lfo_t c = a;
+            lfo_fill(&a, v, n);
+            lfo_fill_q31(&c, u, n);
+            for (int i = 0; i < n; i++) {
+                lfo_advance(&b, 1);
+                uint32_t want = lfo_tri(b.phase);
+                bad += u[i] != (int32_t)(want >> 1);
+                bad += v[i] != (float)(want >> 8) * (1.0f / 16777216.0f);
+            }
+            bad += a.phase != b.phase || a.rem != b.rem || c.phase != b.phase || c.rem != b.rem;
+        }
+    }
+    CHECK(bad == 0, "%u Hz / %u: %d fill values differ from single ticks", rate, decim, bad);
+}
+
+/* 24 hours through lfo_fill_q31, both LFOs, random block lengths */
+static void check_day(uint32_t rate) {
+    static int32_t v[2][JC_CHUNK];
+    lfo_t l[2];
+    uint64_t wraps[2] = { 0, 0 };
+    uint32_t rng = 99, ph, rem;
+    int bad_end = 0, bad_wrap = 0;
+
+    lfo_init(&l[0], LFO_RATE_MHZ[0], rate);
+    lfo_init(&l[1], LFO_RATE_MHZ[1], rate);
+
+    for (uint64_t t = 0, end = (uint64_t)DAY_SEC * rate; t < end; ) {
+        int n = 1 + (int)(lcg(&rng) % JC_CHUNK);
+        if ((uint64_t)n > end - t) n = (int)(end - t);
+
+        for (int k = 0; k < 2; k++) {
+            const uint32_t start = l[k].phase;
+            lfo_fill_q31(&l[k], v[k], n);
+            exact_phase(t + n, LFO_RATE_MHZ[k], rate, &ph, &rem);
+            bad_end += l[k].phase != ph || l[k].rem != rem;
+            if (l[k].phase >= start) continue;
+
+            /* A cycle started in this block: on tick ceil(c * fs / f) */
+            uint64_t c = ++wraps[k];
+            uint64_t den = (uint64_t)rate * 1000u;
+            uint64_t tw = (c * den + LFO_RATE_MHZ[k] - 1) / LFO_RATE_MHZ[k];
+            uint32_t ph_before;
+            if (tw <= t || tw > t + n) { bad_wrap++; continue; }
+            exact_phase(tw - 1, LFO_RATE_MHZ[k], rate, &ph_before, &rem);
+            exact_phase(tw, LFO_RATE_MHZ[k], rate, &ph, &rem);
+            bad_wrap += !(ph < ph_before) || v[k][tw - t - 1] != (int32_t)(lfo_tri(ph) >> 1);
+        }
+        t += n;
+    }
+
+    for (int k = 0; k < 2; k++) {
+        uint64_t want = (uint64_t)DAY_SEC * LFO_RATE_MHZ[k] / 1000u;
+        CHECK(wraps[k] == want, "%u Hz: LFO %d ran %llu cycles in 24 h, want %llu",
+              rate, k + 1, (unsigned long long)wraps[k], (unsigned long long)want);
+    }
+    CHECK(bad_end == 0, "%u Hz: %d block ends off the exact phase", rate, bad_end);
+    CHECK(bad_wrap == 0, "%u Hz: %d cycles started on the wrong sample", rate, bad_wrap);
+}
+
+/* The same stream in 37- and 128-frame blocks */
+static void check_blocks(const char *model, const char *engine, int max_lsb) {
+    const int total = 44100 * 10;
+    int16_t *a = malloc(sizeof(int16_t) * 2 * total);
+    int16_t *b = malloc(sizeof(int16_t) * 2 * total);
+    int16_t *out[2] = { a, b };
+    const int sizes[2] = { 37, JC_CHUNK };
+    lfo_t lfo[2][2];
+
+    for (int s = 0; s < 2; s++) {
+        void *inst = g_fx_api_v3.create_instance(".", NULL);
+        uint32_t rng = 5;
+        g_fx_api_v3.set_param(inst, "model", model);
+        g_fx_api_v3.set_param(inst, "engine", engine);
+        g_fx_api_v3.set_param(inst, "mode", "I+II");
+        g_fx_api_v3.set_param(inst, "mix", "0.7");
+        test_noise_s16(out[s], total, &rng);
+        for (int i = 0; i < total; i += sizes[s]) {
+            int n = total - i < sizes[s] ? total - i : sizes[s];
+            g_fx_api_v3.process_block(inst, out[s] + i * 2, n);
+        }
+        lfo[s][0] = ((jc_instance_t *)inst)->lfo1;
+        lfo[s][1] = ((jc_instance_t *)inst)->lfo2;
+        g_fx_api_v3.destroy_instance(inst);
+    }
+
+    int worst = 0;
+    for (int i = 0; i < total * 2; i++) {
+        int d = abs(a[i] - b[i]);
+        if (d > worst) worst = d;
+    }
+    CHECK(memcmp(lfo[0], lfo[1], sizeof(lfo[0])) == 0,
+          "%s/%s: LFO state depends on block size", model, engine);
+    CHECK(worst <= max_lsb, "%s/%s: 37- and 128-frame blocks differ by %d LSB",
+          model, engine, worst);
+    free(a);
+    free(b);
+}
+
+int main(void) {
+    static const uint32_t rates[] = { 8000, 22050, 44100, 48000, 96000, 192000 };
+    for (int r = 0; r < 6; r++) {
+        check_fill(rates[r], 1);
+        check_fill(rates[r], 2);
+    }
+
+    check_day(44100);
+
+    /* Both engines' block filters round per chunk (1 LSB) */
+    move_audio_fx_init_v3(NULL);
+    check_blocks("ideal", "fixed", 1);
+    check_blocks("ideal", "float", 1);
+    check_blocks("bbd", "float", 1);
+
+    return test_finish("lfo");
+}
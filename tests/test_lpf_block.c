@@ -0,0 +1,112 @@
+/*
+ * Block-parallel one-poles: fo_lpf_block and fo_lpf_block_stereo
+ * against the per-frame fo_lpf_process over a long run of full-scale
+ * noise, in pipeline-sized chunks, at the pre- and post-filter cutoffs.
+ * All three must stay within LPF_TOL of a double-precision recurrence
+ * and of each other, and the last LPF_TAIL samples must be no worse
+ * than the first, so nothing accumulates across chunks.
+ *
+ * The Q30 filters (fo_lpf_process_q, fo_lpf_block_q) are stepped from
+ * -STEP_Q30 to +STEP_Q30 and back, where x - state leaves int32: both
+ * must follow a double recurrence to within LPF_Q_TOL, never moving
+ * away from the input (beyond rounding), as they would if the
+ * difference wrapped.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+#define LPF_LEN  (1 << 24)      /* about 6.3 minutes at 44.1 kHz */
+#define LPF_TAIL (1 << 20)
+#define LPF_TOL  3e-7           /* about 2.5 float ulp at full scale */
+#define STEP_Q30  ((int32_t)(1.1 * (1 << 30)))  /* I+II wet peak */
+#define LPF_Q_TOL 4096.0        /* Q30 units: 1/8 LSB of the int16 output */
+#define LPF_Q_JITTER 16         /* Q31 coefficient rounding at the target */
+
+/* Q30 step response, per frame or in blocks; worst error against double */
+static double step_q(float alpha, int block, int *wrong_way) {
+    fo_lpf_q_t c;
+    int32_t x[JC_CHUNK];
+    int32_t state = -STEP_Q30;
+    double ref = -STEP_Q30, err = 0.0;
+
+    fo_lpf_q_init(&c, alpha);
+    for (int k = 0; k < 64; k++) {
+        const int32_t in = (k & 16) ? -STEP_Q30 : STEP_Q30;
+        int32_t prev = state;
+        for (int i = 0; i < JC_CHUNK; i++) x[i] = in;
+        if (block) fo_lpf_block_q(&state, &c, x, JC_CHUNK);
+        else for (int i = 0; i < JC_CHUNK; i++) x[i] = fo_lpf_process_q(&state, c.alpha, x[i]);
+        for (int i = 0; i < JC_CHUNK; i++) {
+            ref += (double)fminf(alpha, 1.0f) * ((double)in - ref);
+            err = fmax(err, fabs(x[i] - ref));
+            int64_t back = in > 0 ? (int64_t)prev - x[i] : (int64_t)x[i] - prev;
+            *wrong_way += back > LPF_Q_JITTER;
+            prev = x[i];
+        }
+    }
+    return err;
+}
+
+int main(void) {
+    const float cutoffs[] = { PRE_LPF_MIN, POST_LPF_MIN, POST_LPF_MAX };
+
+    for (size_t c = 0; c < sizeof(cutoffs) / sizeof(cutoffs[0]); c++) {
+        float alpha = fo_lpf_alpha(cutoffs[c], DEFAULT_SAMPLE_RATE);
+        fo_lpf_t serial = { alpha, 0.0f };
+        fo_lpf_t block = { alpha, 0.0f };
+        fo_lpf_t st_l = { alpha, 0.0f };
+        fo_lpf_t st_r = { alpha, 0.0f };
+        double ref = 0.0;
+        double err_serial = 0.0, err_block = 0.0, err_stereo = 0.0, diff = 0.0;
+        double head = 0.0, tail = 0.0;
+        float x[JC_CHUNK], y[JC_CHUNK], l[JC_CHUNK], r[JC_CHUNK];
+        uint32_t rng = 1;
+
+        for (int base = 0; base < LPF_LEN; base += JC_CHUNK) {
+            for (int i = 0; i < JC_CHUNK; i++) {
+                rng = rng * 1664525u + 1013904223u;
+                x[i] = y[i] = l[i] = (float)(rng >> 8) / 8388608.0f - 1.0f;
+                r[i] = -x[i];
+            }
+            fo_lpf_block(&block, y, JC_CHUNK);
+            fo_lpf_block_stereo(&st_l, &st_r, l, r, JC_CHUNK);
+
+            for (int i = 0; i < JC_CHUNK; i++) {
+                float s = fo_lpf_process(&serial, x[i]);
+                ref += alpha * ((double)x[i] - ref);
+                double eb = fabs(y[i] - ref);
+                double es = fmax(fabs(l[i] - ref), fabs(r[i] + ref));
+                err_serial = fmax(err_serial, fabs(s - ref));
+                err_block = fmax(err_block, eb);
+                err_stereo = fmax(err_stereo, es);
+                diff = fmax(diff, fabs(y[i] - s));
+                if (base < LPF_TAIL) head = fmax(head, fmax(eb, es));
+                if (base >= LPF_LEN - LPF_TAIL) tail = fmax(tail, fmax(eb, es));
+            }
+        }
+
+        CHECK(err_serial <= LPF_TOL, "%.0f Hz: per-frame error %.3g", cutoffs[c], err_serial);
+        CHECK(err_block <= LPF_TOL, "%.0f Hz: block error %.3g", cutoffs[c], err_block);
+        CHECK(err_stereo <= LPF_TOL, "%.0f Hz: stereo error %.3g", cutoffs[c], err_stereo);
+        CHECK(diff <= LPF_TOL, "%.0f Hz: block vs per-frame %.3g", cutoffs[c], diff);
+        CHECK(tail <= head * 1.25, "%.0f Hz: error grew from %.3g to %.3g",
+              cutoffs[c], head, tail);
+        printf("(%.0f Hz: block %.3g, stereo %.3g, first %.3g / last %.3g)\n",
+               cutoffs[c], err_block, err_stereo, head, tail);
+    }
+
+    const float alphas[] = { fo_lpf_alpha(PRE_LPF_MIN, DEFAULT_SAMPLE_RATE),
+                             fo_lpf_alpha(POST_LPF_MAX, DEFAULT_SAMPLE_RATE), 0.5f, 1.0f };
+    for (size_t a = 0; a < sizeof(alphas) / sizeof(alphas[0]); a++)
+        for (int block = 0; block < 2; block++) {
+            int wrong_way = 0;
+            double err = step_q(alphas[a], block, &wrong_way);
+            const char *form = block ? "block" : "per-frame";
+            CHECK(err <= LPF_Q_TOL, "alpha %.4f, Q30 %s step: error %.0f", alphas[a], form, err);
+            CHECK(wrong_way == 0, "alpha %.4f, Q30 %s step: %d samples moved away from the input",
+                  alphas[a], form, wrong_way);
+        }
+
+    return test_finish("lpf_block");
+}
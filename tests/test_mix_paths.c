@@ -0,0 +1,93 @@
+/*
+ * Mix endpoint fast paths: at mix 0 the output must be the input bit
+ * for bit (bypass), and at mix 0 and 1 the shortcuts must match the
+ * general dry/wet loop bit for bit. A second instance is held on the
+ * general loop by leaving its mix ramps running at their endpoint
+ * values. Covers process_block on both engines and process_block_f32.
+ * The one exception is mix 0 on the int16 float engine, where the
+ * general loop goes through the lossy int16 -> float -> int16 round
+ * trip that the bypass exists to avoid.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+#define BLOCKS 300
+
+enum { PATH_S16_FLOAT, PATH_S16_FIXED, PATH_F32, NUM_PATHS };
+static const char *PATH_NAMES[NUM_PATHS] = { "s16 float", "s16 fixed", "f32" };
+
+static void *make_instance(const char *mix, int path) {
+    void *inst = g_fx_api_v3.create_instance(".", NULL);
+    g_fx_api_v3.set_param(inst, "mode", "I+II");
+    g_fx_api_v3.set_param(inst, "brightness", "0.7");
+    g_fx_api_v3.set_param(inst, "mix", mix);
+    g_fx_api_v3.set_param(inst, "engine", path == PATH_S16_FIXED ? "fixed" : "float");
+    return inst;
+}
+
+/* Keep the mix ramps "running" at their current value: no fast path */
+static void hold_general_mix(jc_instance_t *inst) {
+    inst->dry_g.step = inst->wet_g.step = 0.0f;
+    inst->dry_g.left = inst->wet_g.left = 1 << 30;
+}
+
+static int run(const char *mix, int path) {
+    void *a = make_instance(mix, path);
+    void *b = make_instance(mix, path);
+    static int16_t in[JC_CHUNK * 2], out_a[JC_CHUNK * 2], out_b[JC_CHUNK * 2];
+    static float fin[JC_CHUNK * 2], fout_a[JC_CHUNK * 2], fout_b[JC_CHUNK * 2];
+    const int bypass = strcmp(mix, "0") == 0;
+    const int lossy = bypass && path == PATH_S16_FLOAT;
+    uint32_t rng = 3;
+    int bad_ab = 0, bad_in = 0, fast = 1;
+
+    for (int blk = 0; blk < BLOCKS; blk++) {
+        const int n = blk & 1 ? 37 : JC_CHUNK;
+        test_noise_s16(in, n, &rng);
+        if (path == PATH_F32) {
+            for (int i = 0; i < n * 2; i++) fin[i] = in[i] * (1.0f / 32768.0f);
+            memcpy(fout_a, fin, sizeof(float) * 2 * n);
+            memcpy(fout_b, fin, sizeof(float) * 2 * n);
+            g_fx_api_v3.process_block_f32(a, fout_a, n);
+            g_fx_api_v3.process_block_f32(b, fout_b, n);
+            bad_ab += memcmp(fout_a, fout_b, sizeof(float) * 2 * n) != 0;
+            bad_in += bypass && memcmp(fout_a, fin, sizeof(float) * 2 * n) != 0;
+        } else {
+            memcpy(out_a, in, sizeof(int16_t) * 2 * n);
+            memcpy(out_b, in, sizeof(int16_t) * 2 * n);
+            g_fx_api_v3.process_block(a, out_a, n);
+            g_fx_api_v3.process_block(b, out_b, n);
+            bad_ab += !lossy && memcmp(out_a, out_b, sizeof(int16_t) * 2 * n) != 0;
+            bad_in += bypass && memcmp(out_a, in, sizeof(int16_t) * 2 * n) != 0;
+        }
+        /* The first block snaps the gains; from then on b stays general */
+        if (blk == 0) hold_general_mix((jc_instance_t *)b);
+        jc_instance_t *ia = (jc_instance_t *)a;
+        fast &= !ia->dry_g.left && !ia->wet_g.left &&
+                ia->dry_g.value == (bypass ? 1.0f : 0.0f) &&
+                ia->wet_g.value == (bypass ? 0.0f : 1.0f);
+    }
+
+    CHECK(fast, "mix %s, %s: reference instance left the fast path", mix, PATH_NAMES[path]);
+    CHECK(bad_ab == 0, "mix %s, %s: %d/%d blocks differ from the general mix",
+          mix, PATH_NAMES[path], bad_ab, BLOCKS);
+    CHECK(bad_in == 0, "mix %s, %s: %d/%d bypassed blocks differ from the input",
+          mix, PATH_NAMES[path], bad_in, BLOCKS);
+    CHECK(((jc_instance_t *)a)->engine_on ==
+          (path == PATH_S16_FIXED ? JC_ENGINE_FIXED : JC_ENGINE_FLOAT),
+          "mix %s, %s: wrong engine", mix, PATH_NAMES[path]);
+
+    g_fx_api_v3.destroy_instance(a);
+    g_fx_api_v3.destroy_instance(b);
+    return 0;
+}
+
+int main(void) {
+    move_audio_fx_init_v3(NULL);
+    for (int path = 0; path < NUM_PATHS; path++) {
+        run("0", path);
+        run("1", path);
+    }
+    return test_finish("mix_paths");
+}
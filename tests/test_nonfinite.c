@@ -0,0 +1,134 @@
+/*
+ * Non-finite and denormal input through process_block_f32: every chunk
+ * where a NaN or Inf reaches the filter state counts one reset and
+ * comes out silent, the chunks around it stay finite and the wet path
+ * recovers; near-denormal input never leaves subnormal filter state
+ * and never counts as a reset. The test clears FTZ/DAZ itself (-Ofast
+ * startup code sets them), so the plugin's own switch is what keeps
+ * state normal, and checks it is put back after each block.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+#define FRAMES (JC_CHUNK * 2)
+
+/* Subnormal by its bits; -Ofast may fold fpclassify */
+static int subnormal(float x) {
+    uint32_t u;
+    memcpy(&u, &x, sizeof(u));
+    return (u & 0x7f800000u) == 0 && (u & 0x007fffffu) != 0;
+}
+
+static unsigned resets(void *inst) {
+    char buf[32];
+    g_fx_api_v3.get_param(inst, "nonfinite_resets", buf, sizeof(buf));
+    return (unsigned)strtoul(buf, NULL, 10);
+}
+
+static int all_finite(const float *io, int n) {
+    for (int i = 0; i < n * 2; i++)
+        if (!test_finite(io[i])) return 0;
+    return 1;
+}
+
+static int state_subnormal(const jc_instance_t *in) {
+    return subnormal(in->pre_lpf.state) || subnormal(in->post_lpf_l.state) ||
+           subnormal(in->post_lpf_r.state);
+}
+
+static void noise(float *io, int n, uint32_t *rng) {
+    int16_t s[FRAMES * 2];
+    test_noise_s16(s, n, rng);
+    for (int i = 0; i < n * 2; i++) io[i] = s[i] * (1.0f / 32768.0f);
+}
+
+/* Process one block; also checks the FP control word is restored */
+static void process(void *inst, float *io, int n) {
+#if defined(__SSE__)
+    unsigned int csr = _mm_getcsr();
+    g_fx_api_v3.process_block_f32(inst, io, n);
+    CHECK(_mm_getcsr() == csr, "MXCSR %#x after the block, was %#x", _mm_getcsr(), csr);
+#else
+    g_fx_api_v3.process_block_f32(inst, io, n);
+#endif
+}
+
+static void run(const char *model, const char *half, const char *mix) {
+    void *inst = g_fx_api_v3.create_instance(".", NULL);
+    jc_instance_t *in = (jc_instance_t *)inst;
+    static float io[FRAMES * 2], ref[FRAMES * 2];
+    uint32_t rng = 11;
+    const int bypass = strcmp(mix, "0") == 0;
+
+    g_fx_api_v3.set_param(inst, "model", model);
+    g_fx_api_v3.set_param(inst, "half_rate", half);
+    g_fx_api_v3.set_param(inst, "mix", mix);
+    g_fx_api_v3.set_param(inst, "brightness", "0.5");
+    for (int b = 0; b < 8; b++) {
+        noise(io, FRAMES, &rng);
+        process(inst, io, FRAMES);
+    }
+    const unsigned r0 = resets(inst);
+
+    /* NaN in the first chunk, +Inf in the second, -Inf in both */
+    noise(io, FRAMES, &rng);
+    io[20] = NAN;
+    process(inst, io, FRAMES);
+    CHECK(bypass || all_finite(io, FRAMES), "%s/%s/mix %s: output after NaN not finite", model, half, mix);
+    noise(io, FRAMES, &rng);
+    io[(JC_CHUNK + 7) * 2 + 1] = INFINITY;
+    process(inst, io, FRAMES);
+    CHECK(bypass || all_finite(io, FRAMES), "%s/%s/mix %s: output after +Inf not finite", model, half, mix);
+    noise(io, FRAMES, &rng);
+    io[0] = io[JC_CHUNK * 2] = -INFINITY;
+    process(inst, io, FRAMES);
+    CHECK(bypass || all_finite(io, FRAMES), "%s/%s/mix %s: output after -Inf not finite", model, half, mix);
+    CHECK(resets(inst) - r0 == 4, "%s/%s/mix %s: %u resets, want 4", model, half, mix, resets(inst) - r0);
+    CHECK(!jc_state_nonfinite(in), "%s/%s/mix %s: state still poisoned", model, half, mix);
+
+    /* Clean input afterwards: finite, and the wet path (or bypass) is back */
+    float peak = 0.0f;
+    for (int b = 0; b < 8; b++) {
+        noise(io, FRAMES, &rng);
+        memcpy(ref, io, sizeof(io));
+        process(inst, io, FRAMES);
+        CHECK(all_finite(io, FRAMES), "%s/%s/mix %s: output %d blocks after recovery not finite",
+              model, half, mix, b);
+        if (bypass)
+            CHECK(memcmp(io, ref, sizeof(io)) == 0, "%s/%s/mix %s: bypass not bit-exact after reset",
+                  model, half, mix);
+        for (int i = 0; i < FRAMES * 2; i++) peak = fmaxf(peak, fabsf(io[i]));
+    }
+    CHECK(peak > 0.01f, "%s/%s/mix %s: silent after recovery (peak %g)", model, half, mix, peak);
+
+    /* Near-denormal input, then the tail decaying on true silence */
+    for (int b = 0; b < 64; b++) {
+        for (int i = 0; i < FRAMES * 2; i++) io[i] = (i & 1) ? 1e-39f : -1e-39f;
+        if (b >= 32) memset(io, 0, sizeof(io));
+        process(inst, io, FRAMES);
+        CHECK(all_finite(io, FRAMES), "%s/%s/mix %s: denormal input gave non-finite output",
+              model, half, mix);
+        CHECK(!state_subnormal(in), "%s/%s/mix %s: subnormal filter state after block %d",
+              model, half, mix, b);
+    }
+    CHECK(resets(inst) - r0 == 4, "%s/%s/mix %s: denormals counted as resets (%u)",
+          model, half, mix, resets(inst) - r0);
+
+    g_fx_api_v3.destroy_instance(inst);
+}
+
+int main(void) {
+#if defined(__SSE__)
+    _mm_setcsr(_mm_getcsr() & ~0x8040u);
+#endif
+    move_audio_fx_init_v3(NULL);
+
+    static const char *models[][2] = { { "ideal", "off" }, { "ideal", "on" }, { "bbd", "off" } };
+    static const char *mixes[] = { "0", "0.5", "1" };
+    for (int m = 0; m < 3; m++)
+        for (int x = 0; x < 3; x++)
+            run(models[m][0], models[m][1], mixes[x]);
+
+    return test_finish("nonfinite");
+}
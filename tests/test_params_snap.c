@@ -0,0 +1,58 @@
+/*
+ * Parameters set after create_instance but before the first block
+ * (patch restore, offline renders) take effect at once; changes after
+ * the first block ramp over SMOOTH_SEC as usual.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+static int ramping(const jc_instance_t *in) {
+    return in->gain_a.left || in->gain_b.left || in->dry_g.left ||
+           in->wet_g.left || in->pre_alpha.left || in->post_alpha.left;
+}
+
+int main(void) {
+    move_audio_fx_init_v3(NULL);
+    int16_t buf[JC_CHUNK * 2];
+    float fbuf[JC_CHUNK * 2] = { 0 };
+    uint32_t rng = 1;
+
+    /* Each entry point, and a state restore as well as single keys */
+    for (int path = 0; path < 3; path++) {
+        void *inst = g_fx_api_v3.create_instance(".", NULL);
+        jc_instance_t *in = (jc_instance_t *)inst;
+        if (path == 2) {
+            g_fx_api_v3.set_param(inst, "state",
+                "{\"mode\":2,\"mix\":1,\"brightness\":0,\"half_rate\":0,"
+                "\"model\":0,\"quality\":0,\"engine\":0}");
+        } else {
+            g_fx_api_v3.set_param(inst, "mode", "II");
+            g_fx_api_v3.set_param(inst, "mix", "1");
+            g_fx_api_v3.set_param(inst, "brightness", "0");
+        }
+
+        test_noise_s16(buf, JC_CHUNK, &rng);
+        if (path == 1) g_fx_api_v3.process_block_f32(inst, fbuf, JC_CHUNK);
+        else           g_fx_api_v3.process_block(inst, buf, JC_CHUNK);
+
+        CHECK(!ramping(in), "path %d: first block ramped from the defaults", path);
+        CHECK(in->gain_a.value == 0.0f && in->gain_b.value == 1.0f,
+              "path %d: mode gains %g/%g", path, in->gain_a.value, in->gain_b.value);
+        CHECK(in->dry_g.value == 0.0f && in->wet_g.value == 1.0f,
+              "path %d: mix gains %g/%g", path, in->dry_g.value, in->wet_g.value);
+        CHECK(in->pre_lpf.alpha == in->cur.pre_alpha &&
+              in->post_lpf_l.alpha == in->cur.post_alpha,
+              "path %d: filters not on the brightness setting", path);
+
+        /* After a block has run, changes are smoothed */
+        g_fx_api_v3.set_param(inst, "mix", "0.5");
+        g_fx_api_v3.process_block(inst, buf, 16);
+        CHECK(in->dry_g.left > 0 && in->wet_g.left > 0,
+              "path %d: change after the first block did not ramp", path);
+
+        g_fx_api_v3.destroy_instance(inst);
+    }
+
+    return test_finish("params_snap");
+}
@@ -0,0 +1,100 @@
+/*
+ * Parameter handoff under concurrency: a control thread hammers
+ * set_param/get_param while the audio thread runs process_block and
+ * process_block_f32 on the same instance. Built with
+ * -fsanitize=thread by run_tests.sh, so any data race in the triple
+ * buffer (or anything else the two threads share) fails the run.
+ * Afterwards the audio thread must pick up the last published values.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+#include <pthread.h>
+
+#define CONTROL_ROUNDS 20000
+
+static atomic_int g_done;
+
+static void *control_thread(void *arg) {
+    void *inst = arg;
+    static const char *keys[] = { "mode", "mix", "brightness", "model",
+                                  "quality", "engine", "half_rate" };
+    static const char *vals[][3] = {
+        { "I", "I+II", "II" },
+        { "0", "0.37", "1" },
+        { "0", "0.5", "1" },
+        { "ideal", "bbd", "ideal" },
+        { "linear", "hermite", "thiran" },
+        { "float", "fixed", "float" },
+        { "off", "on", "off" },
+    };
+    char buf[512];
+    uint32_t rng = 7;
+
+    for (int r = 0; r < CONTROL_ROUNDS; r++) {
+        rng = rng * 1664525u + 1013904223u;
+        int k = (int)((rng >> 8) % 7u);
+        g_fx_api_v3.set_param(inst, keys[k], vals[k][(rng >> 16) % 3u]);
+        if ((r & 63) == 0)
+            g_fx_api_v3.set_param(inst, "state",
+                "{\"mode\":2,\"mix\":0.8,\"brightness\":0.3,\"half_rate\":0,"
+                "\"model\":0,\"quality\":1,\"engine\":0}");
+        g_fx_api_v3.get_param(inst, "state", buf, sizeof(buf));
+        g_fx_api_v3.get_param(inst, "tail_samples", buf, sizeof(buf));
+        g_fx_api_v3.get_param(inst, "nonfinite_resets", buf, sizeof(buf));
+    }
+
+    /* Final settings the audio thread has to end up on */
+    g_fx_api_v3.set_param(inst, "model", "ideal");
+    g_fx_api_v3.set_param(inst, "engine", "float");
+    g_fx_api_v3.set_param(inst, "half_rate", "off");
+    g_fx_api_v3.set_param(inst, "mode", "II");
+    g_fx_api_v3.set_param(inst, "mix", "1");
+    atomic_store(&g_done, 1);
+    return NULL;
+}
+
+int main(void) {
+    move_audio_fx_init_v3(NULL);
+    void *inst = g_fx_api_v3.create_instance(".", NULL);
+    CHECK(inst != NULL, "create_instance failed");
+    if (!inst) return test_finish("params_threads");
+
+    int16_t buf[JC_CHUNK * 2];
+    float fbuf[JC_CHUNK * 2];
+    uint32_t rng = 1;
+    long blocks = 0;
+
+    pthread_t th;
+    CHECK(pthread_create(&th, NULL, control_thread, inst) == 0, "pthread_create failed");
+
+    while (!atomic_load(&g_done)) {
+        test_noise_s16(buf, JC_CHUNK, &rng);
+        if (blocks & 1) {
+            for (int i = 0; i < JC_CHUNK * 2; i++) fbuf[i] = buf[i] / 32768.0f;
+            g_fx_api_v3.process_block_f32(inst, fbuf, JC_CHUNK);
+        } else {
+            g_fx_api_v3.process_block(inst, buf, JC_CHUNK);
+        }
+        blocks++;
+    }
+    pthread_join(th, NULL);
+
+    /* One more block publishes nothing new; the snapshot is the last one */
+    test_noise_s16(buf, JC_CHUNK, &rng);
+    g_fx_api_v3.process_block(inst, buf, JC_CHUNK);
+
+    jc_instance_t *in = (jc_instance_t *)inst;
+    CHECK(blocks > 0, "audio thread never ran");
+    CHECK(in->cur.gain_a == MODE_GAIN[2][0] && in->cur.gain_b == MODE_GAIN[2][1],
+          "mode gains %g/%g, want mode II", in->cur.gain_a, in->cur.gain_b);
+    CHECK(in->cur.dry_g == 0.0f && in->cur.wet_g == 1.0f,
+          "mix gains %g/%g, want full wet", in->cur.dry_g, in->cur.wet_g);
+    CHECK(in->cur.model == JC_MODEL_IDEAL && in->cur.engine == JC_ENGINE_FLOAT &&
+          !in->cur.half_rate, "engine settings not the last published");
+
+    g_fx_api_v3.destroy_instance(inst);
+    printf("(%ld audio blocks against %d control rounds)\n", blocks, CONTROL_ROUNDS);
+    return test_finish("params_threads");
+}
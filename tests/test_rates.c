@@ -0,0 +1,131 @@
+/*
+ * Rate-dependent constants at 44.1, 48 and 96 kHz: delay range, LFO
+ * rates, smoothing time and filter cutoffs must come out the same in
+ * seconds and hertz whatever the host rate, on the full-rate and
+ * half-rate ring. The delay is also measured end to end as the
+ * centroid of an impulse through the wet path.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+static const int RATES[] = { 44100, 48000, 96000 };
+#define NUM_RATES ((int)(sizeof(RATES) / sizeof(RATES[0])))
+
+/* LFO frequency in Hz at ring_rate ticks per second */
+static double lfo_hz(const lfo_t *l, double ring_rate) {
+    return ((double)l->inc + (double)l->inc_frac / l->den) * ring_rate / 4294967296.0;
+}
+
+/* Cutoff in Hz that fo_lpf_alpha turned into alpha */
+static double lpf_hz(float alpha, double rate) {
+    return alpha / (1.0 - alpha) * rate / (2.0 * M_PI);
+}
+
+/*
+ * Centroid, in seconds, of the wet response to a small impulse (mode I,
+ * mix 1, LFO near its minimum, so the tap sits at DELAY_MIN_SEC)
+ */
+static double impulse_delay_sec(void *inst, double rate) {
+    float io[JC_CHUNK * 2] = { 0 };
+    double sum = 0.0, moment = 0.0;
+
+    io[0] = io[1] = 0.25f;
+    for (int base = 0; base < (int)(0.01 * rate); base += JC_CHUNK) {
+        g_fx_api_v3.process_block_f32(inst, io, JC_CHUNK);
+        for (int i = 0; i < JC_CHUNK; i++) {
+            double y = fabs(io[i * 2]);
+            sum += y;
+            moment += y * (base + i);
+        }
+        memset(io, 0, sizeof(io));
+    }
+    return moment / sum / rate;
+}
+
+int main(void) {
+    static host_api_v1_t host;
+    double hz1[NUM_RATES], delay[NUM_RATES];
+
+    for (int r = 0; r < NUM_RATES; r++) {
+        const double rate = RATES[r];
+        memset(&host, 0, sizeof(host));
+        host.api_version = MOVE_PLUGIN_API_VERSION;
+        host.sample_rate = RATES[r];
+        host.frames_per_block = JC_CHUNK;
+        move_audio_fx_init_v3(&host);
+
+        void *inst = g_fx_api_v3.create_instance(".", NULL);
+        jc_instance_t *in = (jc_instance_t *)inst;
+        CHECK(in->sample_rate == (float)rate, "%d Hz: instance at %g", RATES[r], in->sample_rate);
+
+        /* Full-rate ring */
+        CHECK(fabs(in->dt_min / rate - DELAY_MIN_SEC) < 1e-7,
+              "%d Hz: min delay %.6f ms", RATES[r], in->dt_min / rate * 1e3);
+        CHECK(fabs((in->dt_min + in->dt_rng) / rate - DELAY_MAX_SEC) < 1e-7,
+              "%d Hz: max delay %.6f ms", RATES[r], (in->dt_min + in->dt_rng) / rate * 1e3);
+        CHECK(fabs(lfo_hz(&in->lfo1, rate) - LFO_RATE_MHZ[0] * 1e-3) < 1e-9 &&
+              fabs(lfo_hz(&in->lfo2, rate) - LFO_RATE_MHZ[1] * 1e-3) < 1e-9,
+              "%d Hz: LFOs at %.9f / %.9f Hz", RATES[r],
+              lfo_hz(&in->lfo1, rate), lfo_hz(&in->lfo2, rate));
+        CHECK(fabs(in->smooth_frames / rate - SMOOTH_SEC) <= 1.0 / rate,
+              "%d Hz: smoothing %.3f ms", RATES[r], in->smooth_frames / rate * 1e3);
+
+        /* Brightness 0 puts both filters at their minimum cutoff */
+        g_fx_api_v3.set_param(inst, "brightness", "0");
+        g_fx_api_v3.set_param(inst, "mode", "I");
+        g_fx_api_v3.set_param(inst, "mix", "1");
+        float buf[JC_CHUNK * 2] = { 0 };
+        g_fx_api_v3.process_block_f32(inst, buf, JC_CHUNK);
+        CHECK(fabs(lpf_hz(in->pre_lpf.alpha, rate) - PRE_LPF_MIN) < 0.01 * PRE_LPF_MIN &&
+              fabs(lpf_hz(in->post_lpf_l.alpha, rate) - POST_LPF_MIN) < 0.01 * POST_LPF_MIN,
+              "%d Hz: cutoffs %.1f / %.1f Hz", RATES[r],
+              lpf_hz(in->pre_lpf.alpha, rate), lpf_hz(in->post_lpf_l.alpha, rate));
+
+        /* An exact rate: 1000 s is a whole number of LFO cycles */
+        lfo_t l1 = in->lfo1, l2 = in->lfo2;
+        const lfo_t s1 = l1, s2 = l2;
+        for (long t = 0, end = 1000L * RATES[r]; t < end; t += JC_CHUNK) {
+            int n = end - t < JC_CHUNK ? (int)(end - t) : JC_CHUNK;
+            lfo_advance(&l1, n);
+            lfo_advance(&l2, n);
+        }
+        CHECK(l1.phase == s1.phase && l2.phase == s2.phase &&
+              l1.rem == s1.rem && l2.rem == s2.rem,
+              "%d Hz: LFO phase drifted by %d / %d LSB over 1000 s", RATES[r],
+              (int32_t)(l1.phase - s1.phase), (int32_t)(l2.phase - s2.phase));
+
+        /* Half-rate ring: the same times and rates at half the ticks */
+        g_fx_api_v3.set_param(inst, "half_rate", "on");
+        g_fx_api_v3.process_block_f32(inst, buf, JC_CHUNK);
+        CHECK(in->half_rate_on, "%d Hz: half rate did not engage", RATES[r]);
+        CHECK(fabs(in->dt_min / (rate / 2) - DELAY_MIN_SEC) < 1e-7 &&
+              fabs((in->dt_min + in->dt_rng) / (rate / 2) - DELAY_MAX_SEC) < 1e-7,
+              "%d Hz: half-rate delay range %.6f-%.6f ms", RATES[r],
+              in->dt_min / (rate / 2) * 1e3, (in->dt_min + in->dt_rng) / (rate / 2) * 1e3);
+        CHECK(fabs(lfo_hz(&in->lfo1, rate / 2) - LFO_RATE_MHZ[0] * 1e-3) < 1e-9,
+              "%d Hz: half-rate LFO at %.9f Hz", RATES[r], lfo_hz(&in->lfo1, rate / 2));
+        hz1[r] = lfo_hz(&in->lfo1, rate / 2);
+        g_fx_api_v3.destroy_instance(inst);
+
+        /* End to end on a fresh instance, full brightness */
+        inst = g_fx_api_v3.create_instance(".", NULL);
+        g_fx_api_v3.set_param(inst, "mode", "I");
+        g_fx_api_v3.set_param(inst, "mix", "1");
+        delay[r] = impulse_delay_sec(inst, rate);
+        g_fx_api_v3.destroy_instance(inst);
+    }
+
+    /* The measured delay agrees across rates and with the constant */
+    for (int r = 0; r < NUM_RATES; r++) {
+        CHECK(fabs(delay[r] - delay[0]) < 5e-6,
+              "impulse delay %.4f ms at %d Hz vs %.4f ms at %d Hz",
+              delay[r] * 1e3, RATES[r], delay[0] * 1e3, RATES[0]);
+        CHECK(fabs(delay[r] - DELAY_MIN_SEC) < 50e-6,
+              "impulse delay %.4f ms at %d Hz, want about %.2f ms",
+              delay[r] * 1e3, RATES[r], DELAY_MIN_SEC * 1e3);
+        CHECK(fabs(hz1[r] - hz1[0]) < 1e-9, "half-rate LFO differs at %d Hz", RATES[r]);
+    }
+
+    return test_finish("rates");
+}
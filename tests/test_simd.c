@@ -0,0 +1,214 @@
+/*
+ * jc_simd.h against its scalar definitions, bit for bit, on random
+ * data with edge values mixed in: the int16/float conversions (vector
+ * body plus scalar tail), interleave, widen, saturating narrow,
+ * min/max, the 4x4 transpose, soft_limit_v4, the Q15/Q31 saturating
+ * ops, and the gathered taps: linear, Hermite and Thiran against
+ * delay_read_frac, delay_read_hermite and delay_read_thiran, and the
+ * fixed-point ones (soft_limit_q30_v4, delay_read_q30_v4) against
+ * their scalar forms. The Thiran and soft-limit checks allow
+ * THIRAN_TOL and LIMIT_TOL: -Ofast rewrites the scalar division
+ * differently from the vector one (the last bit of the result), and
+ * the allpass state carries that difference on. Run on each
+ * target it checks that the NEON, SSE and generic branches compute
+ * the same thing. On x86 hosts run_tests.sh also builds it on the
+ * generic branches and on the NEON ones over tests/neon/arm_neon.h;
+ * that checks the NEON branches against an emulation only, so the
+ * real check is this test built for and run on aarch64.
+ */
+
+#include "../src/dsp/junologue_chorus.c"
+#include "jc_test.h"
+
+#define ROUNDS 4096
+#define FRAMES (JC_CHUNK - 3)   /* leaves a scalar tail */
+#define RING   1024
+#define THIRAN_TOL 1e-6f
+#define LIMIT_TOL  2e-7f        /* one float ulp below 1.0, plus a margin */
+
+static uint32_t g_rng = 1;
+
+/* Random bits, with an edge value (0, +-1, extremes) one time in eight */
+static int32_t rand32(void) {
+    static const int32_t edge[8] = { INT32_MIN, INT32_MIN + 1, -65536, -1,
+                                     0, 1, 16384, INT32_MAX };
+    g_rng = g_rng * 1664525u + 1013904223u;
+    if ((g_rng >> 29) == 0) return edge[(g_rng >> 8) & 7];
+    g_rng = g_rng * 1664525u + 1013904223u;
+    return (int32_t)g_rng;
+}
+
+static float randf(void) {
+    return (float)rand32() * 0x1p-31f;
+}
+
+int main(void) {
+    static int16_t s16[JC_CHUNK * 2];
+    static float l[JC_CHUNK], r[JC_CHUNK], lfo[JC_CHUNK], ring[RING];
+    static int16_t qring[RING];
+    long bad_in = 0, bad_out = 0, bad_ld2 = 0, bad_st2 = 0, bad_widen = 0;
+    long bad_minmax = 0, bad_tr = 0, bad_qadd = 0, bad_qdmulh = 0;
+    long bad_qrshrn = 0, bad_narrow = 0, bad_hadd = 0, bad_tap = 0;
+    long bad_herm = 0, bad_thiran = 0, bad_qrdmulh = 0, bad_gather = 0;
+    long bad_qlimit = 0, bad_qtap = 0, bad_limit = 0;
+
+    for (int i = 0; i < RING; i++) ring[i] = randf();
+    for (int i = 0; i < RING; i++) qring[i] = (int16_t)rand32();
+
+    for (int k = 0; k < ROUNDS; k++) {
+        /* Conversions; output covers +-1.5 so the clamp is exercised */
+        for (int i = 0; i < FRAMES * 2; i++) s16[i] = (int16_t)rand32();
+        jc_s16_to_f32(s16, l, r, FRAMES);
+        for (int i = 0; i < FRAMES; i++) {
+            bad_in += l[i] != (float)s16[i * 2] / 32768.0f;
+            bad_in += r[i] != (float)s16[i * 2 + 1] / 32768.0f;
+            l[i] *= 1.5f;
+            r[i] *= 1.5f;
+        }
+        jc_f32_to_s16(l, r, s16, FRAMES);
+        for (int i = 0; i < FRAMES; i++) {
+            float cl = fminf(fmaxf(l[i], -1.0f), 1.0f);
+            float cr = fminf(fmaxf(r[i], -1.0f), 1.0f);
+            bad_out += s16[i * 2]     != (int16_t)(cl * 32767.0f);
+            bad_out += s16[i * 2 + 1] != (int16_t)(cr * 32767.0f);
+        }
+
+        /* Interleave and widen */
+        float f[8], fo[8];
+        int16_t h[16], ho[16];
+        for (int i = 0; i < 8; i++) f[i] = randf();
+        for (int i = 0; i < 16; i++) h[i] = (int16_t)rand32();
+        jc_v4f fa, fb;
+        jc_v8s ha, hb;
+        jc_v4f_load2(f, &fa, &fb);
+        jc_v8s_load2(h, &ha, &hb);
+        for (int i = 0; i < 4; i++)
+            bad_ld2 += fa[i] != f[i * 2] || fb[i] != f[i * 2 + 1];
+        for (int i = 0; i < 8; i++)
+            bad_ld2 += ha[i] != h[i * 2] || hb[i] != h[i * 2 + 1];
+        jc_v4f_store2(fo, fa, fb);
+        jc_v8s_store2(ho, ha, hb);
+        bad_st2 += memcmp(fo, f, sizeof(f)) != 0;
+        bad_st2 += memcmp(ho, h, sizeof(h)) != 0;
+        jc_v4i wl = jc_v8s_lo(ha), wh = jc_v8s_hi(ha);
+        for (int i = 0; i < 4; i++)
+            bad_widen += wl[i] != ha[i] || wh[i] != ha[i + 4];
+
+        /* Min/max and transpose */
+        jc_v4f mn = jc_v4f_min(fa, fb), mx = jc_v4f_max(fa, fb);
+        for (int i = 0; i < 4; i++)
+            bad_minmax += mn[i] != fminf(fa[i], fb[i]) || mx[i] != fmaxf(fa[i], fb[i]);
+        jc_v4f m[4];
+        for (int j = 0; j < 4; j++)
+            for (int i = 0; i < 4; i++) m[j][i] = (float)(j * 4 + i);
+        jc_v4f_transpose4(m);
+        for (int j = 0; j < 4; j++)
+            for (int i = 0; i < 4; i++) bad_tr += m[j][i] != (float)(i * 4 + j);
+
+        /* Soft limiter, as the lane kernel calls it */
+        jc_v4f lim = soft_limit_v4(fa);
+        for (int i = 0; i < 4; i++) bad_limit += fabsf(lim[i] - soft_limit(fa[i])) > LIMIT_TOL;
+
+        /* Q15 ops, four lanes (eight for the int16 ones) */
+        int32_t a[4], b[4];
+        int16_t x[8], y[8];
+        for (int i = 0; i < 4; i++) { a[i] = rand32(); b[i] = rand32(); }
+        for (int i = 0; i < 8; i++) { x[i] = (int16_t)rand32(); y[i] = (int16_t)rand32(); }
+        int32_t g = rand32();
+        jc_v4i va = jc_v4i_load(a), vb = jc_v4i_load(b);
+        jc_v4i qadd = jc_v4i_qadd(va, vb);
+        jc_v4i qdmulh_n = jc_v4i_qdmulh_n(va, g);
+        jc_v4i qdmulh = jc_v4i_qdmulh(va, vb);
+        jc_v4i qrdmulh = jc_v4i_qrdmulh(va, vb);
+        jc_v8s qrshrn = jc_v8s_qrshrn15(va, vb);
+        jc_v8s narrow = jc_v8s_narrow(va, vb);
+        jc_v8s hadd = jc_v8s_hadd(jc_v8s_load(x), jc_v8s_load(y));
+        for (int i = 0; i < 4; i++) {
+            bad_qadd   += qadd[i] != jc_qadd_s32(a[i], b[i]);
+            bad_qdmulh += qdmulh_n[i] != jc_qdmulh_s32(a[i], g);
+            bad_qdmulh += qdmulh[i] != jc_qdmulh_s32(a[i], b[i]);
+            bad_qrdmulh += qrdmulh[i] != jc_qrdmulh_s32(a[i], b[i]);
+            bad_qrshrn += qrshrn[i] != jc_qrshrn15_s32(a[i]);
+            bad_qrshrn += qrshrn[i + 4] != jc_qrshrn15_s32(b[i]);
+            bad_narrow += narrow[i] != jc_sat16(a[i]);
+            bad_narrow += narrow[i + 4] != jc_sat16(b[i]);
+        }
+        for (int i = 0; i < 8; i++)
+            bad_hadd += hadd[i] != (int16_t)((x[i] + y[i]) >> 1);
+
+        /* Fixed-point gather and soft limit */
+        jc_v4i idx = jc_v4i_load(a) & (RING - 1);
+        jc_v4i gath = jc_v4i_gather_s16(qring, idx);
+        jc_v4i sl = soft_limit_q30_v4(jc_v8s_lo(jc_v8s_load(x)));
+        for (int i = 0; i < 4; i++) {
+            bad_gather += gath[i] != qring[idx[i]];
+            bad_qlimit += sl[i] != soft_limit_q30(x[i]);
+        }
+
+        /* Gathered linear taps over the chorus delay range */
+        for (int i = 0; i < JC_CHUNK; i++) lfo[i] = randf();
+        const float dt_min = DELAY_MIN_SEC * DEFAULT_SAMPLE_RATE;
+        const float dt_rng = (DELAY_MAX_SEC - DELAY_MIN_SEC) * DEFAULT_SAMPLE_RATE;
+        const float *p = ring + RING - JC_CHUNK;
+        const int16_t *qp = qring + RING - JC_CHUNK;
+        const int32_t qdt_min = (int32_t)(dt_min * 65536.0f);
+        const int32_t qdt_rng = (int32_t)(dt_rng * 65536.0f);
+        for (int i = 0; i + 4 <= JC_CHUNK; i += 4) {
+            /* Q30 taps at 16.16 delays from a random Q31 LFO */
+            jc_v4i qv = jc_v4i_load(a) & INT32_MAX;
+            jc_v4i qd = qdt_min + jc_v4i_qdmulh_n(qv, qdt_rng);
+            jc_v4i q = delay_read_q30_v4(qp + i, qd);
+            for (int j = 0; j < 4; j++)
+                bad_qtap += q[j] != delay_read_q30(qp + i + j, qd[j]);
+            for (int j = 0; j < 4; j++) a[j] = rand32();
+
+            jc_v4f v2 = jc_v4f_load(lfo + i) * jc_v4f_load(lfo + i);
+            jc_v4f d = dt_min + dt_rng * v2;
+            jc_v4f v = delay_read_frac_v4(p + i, d);
+            jc_v4f h = delay_read_hermite_v4(p + i, d);
+            for (int j = 0; j < 4; j++) {
+                bad_tap += v[j] != delay_read_frac(p + i + j, d[j]);
+                bad_herm += h[j] != delay_read_hermite(p + i + j, d[j]);
+            }
+        }
+
+        /* Thiran: four taps of one frame per vector, state carried */
+        jc_v4f y1 = jc_v4f_set1(0.0f);
+        float y1s[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (int i = 0; i + 4 <= JC_CHUNK; i++) {
+            jc_v4f d = dt_min + dt_rng * jc_v4f_load(lfo + i) * jc_v4f_load(lfo + i);
+            jc_v4f y = delay_read_thiran_v4(p + i, d, &y1);
+            for (int j = 0; j < 4; j++)
+                bad_thiran += fabsf(y[j] - delay_read_thiran(p + i, d[j], &y1s[j])) > THIRAN_TOL;
+        }
+    }
+
+    CHECK(bad_in == 0, "s16_to_f32: %ld mismatches", bad_in);
+    CHECK(bad_out == 0, "f32_to_s16: %ld mismatches", bad_out);
+    CHECK(bad_ld2 == 0, "load2: %ld mismatches", bad_ld2);
+    CHECK(bad_st2 == 0, "store2: %ld mismatches", bad_st2);
+    CHECK(bad_widen == 0, "v8s_lo/hi: %ld mismatches", bad_widen);
+    CHECK(bad_minmax == 0, "v4f_min/max: %ld mismatches", bad_minmax);
+    CHECK(bad_tr == 0, "transpose4: %ld mismatches", bad_tr);
+    CHECK(bad_limit == 0, "soft_limit_v4: %ld mismatches", bad_limit);
+    CHECK(bad_qadd == 0, "qadd: %ld mismatches", bad_qadd);
+    CHECK(bad_qdmulh == 0, "qdmulh: %ld mismatches", bad_qdmulh);
+    CHECK(bad_qrdmulh == 0, "qrdmulh: %ld mismatches", bad_qrdmulh);
+    CHECK(bad_qrshrn == 0, "qrshrn15: %ld mismatches", bad_qrshrn);
+    CHECK(bad_narrow == 0, "narrow: %ld mismatches", bad_narrow);
+    CHECK(bad_hadd == 0, "hadd: %ld mismatches", bad_hadd);
+    CHECK(bad_gather == 0, "gather_s16: %ld mismatches", bad_gather);
+    CHECK(bad_qlimit == 0, "soft_limit_q30_v4: %ld mismatches", bad_qlimit);
+    CHECK(bad_tap == 0, "gather_lerp: %ld mismatches", bad_tap);
+    CHECK(bad_herm == 0, "hermite_v4: %ld mismatches", bad_herm);
+    CHECK(bad_thiran == 0, "thiran_v4: %ld mismatches", bad_thiran);
+    CHECK(bad_qtap == 0, "delay_read_q30_v4: %ld mismatches", bad_qtap);
+
+#if JC_HAVE_NEON
+    return test_finish("simd (neon, emulated)");
+#elif defined(__SSE2__)
+    return test_finish("simd (sse)");
+#else
+    return test_finish("simd (generic)");
+#endif
+}
@@ -0,0 +1,704 @@
+/*
+ * jc-bench - microbenchmarks for the Junologue Chorus DSP
+ *
+ * Includes the plugin source directly so the static primitives can be
+ * timed in isolation, then times the full v2 process_block across
+ * block sizes, modes and mix extremes, each process kernel the CPU
+ * supports, and batched instances against one-at-a-time calls. Results go to stdout as one
+ * JSON document so builds can be compared. For the interpolation
+ * tiers it also measures the frequency response error over the
+ * chorus delay range, and for the fixed-point engine its THD+N and
+ * deviation from the float engine.
+ *
+ *   jc-bench [-q] [-m CPU_MHZ]
+ *     -q          quick run (fewer repetitions)
+ *     -m CPU_MHZ  core clock used to turn ns into cycles where no
+ *                 cycle counter is readable (default 1500, Move CM4)
+ *
+ * On x86-64 cycles come from the TSC (reference cycles). On aarch64
+ * the PMU cycle counter is not readable from user space, so cycles are
+ * ns scaled by -m.
+ *
+ * cpu_pct is the share of one core the measured work costs when run
+ * once per sample at the plugin sample rate; for process_block that
+ * is the per-instance load.
+ */
+
+#include "../../src/dsp/junologue_chorus.c"
+
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_TSC 1
+#else
+#define BENCH_HAVE_TSC 0
+#endif
+
+#define BENCH_SAMPLES 4096
+
+typedef void (*bench_fn)(void *ctx, int n);
+
+static volatile float g_sink;
+static int   g_reps = 50;
+static double g_cpu_mhz = 1500.0;
+static int   g_first = 1;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static uint64_t now_cycles(void) {
+#if BENCH_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/*
+ * Time fn(ctx, n) and report the best of g_reps runs per sample; the
+ * ns per sample is returned too. extra is a preformatted JSON fragment
+ * (without braces) or "".
+ */
+static double bench_report(const char *name, const char *extra,
+                         bench_fn fn, void *ctx, int n, int samples_per_call) {
+    double best_ns = 1e30;
+    double best_cyc = 1e30;
+
+    fn(ctx, n);  /* warm caches and branch predictors */
+    for (int r = 0; r < g_reps; r++) {
+        uint64_t c0 = now_cycles();
+        double t0 = now_ns();
+        fn(ctx, n);
+        double t1 = now_ns();
+        uint64_t c1 = now_cycles();
+        if (t1 - t0 < best_ns) best_ns = t1 - t0;
+        if ((double)(c1 - c0) < best_cyc) best_cyc = (double)(c1 - c0);
+    }
+
+    double samples = (double)n * samples_per_call;
+    double ns = best_ns / samples;
+    double cyc = BENCH_HAVE_TSC ? best_cyc / samples : ns * g_cpu_mhz * 1e-3;
+
+    printf("%s    {\"name\":\"%s\"%s%s,\"ns_per_sample\":%.4f,"
+           "\"cycles_per_sample\":%.3f,\"cpu_pct\":%.4f}",
+           g_first ? "" : ",\n", name, extra[0] ? "," : "", extra, ns, cyc,
+           ns * DEFAULT_SAMPLE_RATE * 1e-7);
+    g_first = 0;
+    return ns;
+}
+
+/* --- Primitive benchmarks --- */
+
+static float g_in[BENCH_SAMPLES];
+static float g_out[BENCH_SAMPLES];
+
+static void run_soft_limit(void *ctx, int n) {
+    (void)ctx;
+    for (int i = 0; i < n; i++) g_out[i] = soft_limit(g_in[i]);
+    g_sink = g_out[n - 1];
+}
+
+static void run_fast_sqrt(void *ctx, int n) {
+    (void)ctx;
+    for (int i = 0; i < n; i++) g_out[i] = fast_sqrt(g_in[i] * g_in[i]);
+    g_sink = g_out[n - 1];
+}
+
+static void run_fo_lpf(void *ctx, int n) {
+    fo_lpf_t *f = (fo_lpf_t *)ctx;
+    for (int i = 0; i < n; i++) g_out[i] = fo_lpf_process(f, g_in[i]);
+    g_sink = g_out[n - 1];
+}
+
+static void run_fo_lpf_block(void *ctx, int n) {
+    memcpy(g_out, g_in, (size_t)n * sizeof(float));
+    for (int i = 0; i < n; i += JC_CHUNK)
+        fo_lpf_block((fo_lpf_t *)ctx, g_out + i, JC_CHUNK);
+    g_sink = g_out[n - 1];
+}
+
+/* L = g_in, R = g_out; per stereo frame */
+static void run_fo_lpf_block_stereo(void *ctx, int n) {
+    fo_lpf_t *f = (fo_lpf_t *)ctx;
+    memcpy(g_out, g_in, (size_t)n * sizeof(float));
+    for (int i = 0; i < n; i += JC_CHUNK)
+        fo_lpf_block_stereo(&f[0], &f[1], g_out + i, g_in + i, JC_CHUNK);
+    g_sink = g_out[n - 1];
+}
+
+/* One tap of the given tier, as the core's tap stages read it */
+static inline __attribute__((always_inline))
+float bench_read(const float *p, float delay_samples, float *ap, const int interp) {
+    if (interp == JC_INTERP_THIRAN)  return delay_read_thiran(p, delay_samples, ap);
+    if (interp == JC_INTERP_HERMITE) return delay_read_hermite(p, delay_samples);
+    return delay_read_frac(p, delay_samples);
+}
+
+/* Same sweep for every tier; interp is constant after inlining */
+static inline __attribute__((always_inline))
+void run_delay_read_tmpl(const delay_line_t *d, int n, const int interp) {
+    const float *p = delay_block_base(d, d->reach);
+    const float dt_min = DELAY_MIN_SEC * DEFAULT_SAMPLE_RATE;
+    const float dt_rng = (DELAY_MAX_SEC - DELAY_MIN_SEC) * DEFAULT_SAMPLE_RATE;
+    float acc = 0.0f;
+    float ap = 0.0f;
+    for (int i = 0; i < n; i++) {
+        float dt = dt_min + dt_rng * ((float)(i & 127) * (1.0f / 128.0f));
+        acc += bench_read(p + (i & 127), dt, &ap, interp);
+    }
+    g_sink = acc;
+}
+
+static void run_delay_read(void *ctx, int n) {
+    run_delay_read_tmpl((const delay_line_t *)ctx, n, JC_INTERP_LINEAR);
+}
+
+static void run_delay_read_hermite(void *ctx, int n) {
+    run_delay_read_tmpl((const delay_line_t *)ctx, n, JC_INTERP_HERMITE);
+}
+
+static void run_delay_read_thiran(void *ctx, int n) {
+    run_delay_read_tmpl((const delay_line_t *)ctx, n, JC_INTERP_THIRAN);
+}
+
+/* --- Interpolation accuracy --- */
+
+#define RESP_LEN    8192
+#define RESP_DELAYS 97
+
+/*
+ * Worst magnitude (dB) and phase delay (samples) error of one tier
+ * against an ideal delay at freq_hz, over static delays spanning the
+ * chorus range. The frequency is snapped to a DFT bin of the
+ * measurement window so a single-bin DFT of the interpolated sine is
+ * exact; returns the snapped frequency. The first reach samples are
+ * skipped as warm-up.
+ */
+static double interp_response(int interp, double freq_hz,
+                              double *mag_err_db, double *delay_err) {
+    static float x[RESP_LEN];
+    const float dt_min = DELAY_MIN_SEC * DEFAULT_SAMPLE_RATE;
+    const float dt_rng = (DELAY_MAX_SEC - DELAY_MIN_SEC) * DEFAULT_SAMPLE_RATE;
+    const int start = (int)(dt_min + dt_rng) + 64;
+    const int len = RESP_LEN - start;
+    const double bin = floor(freq_hz * len / DEFAULT_SAMPLE_RATE + 0.5);
+    const double w = 2.0 * M_PI * bin / len;
+
+    for (int i = 0; i < RESP_LEN; i++) x[i] = (float)sin(w * i);
+
+    *mag_err_db = 0.0;
+    *delay_err = 0.0;
+    for (int k = 0; k < RESP_DELAYS; k++) {
+        float dt = dt_min + dt_rng * (float)k / (float)(RESP_DELAYS - 1);
+        float ap = 0.0f;
+        double yr = 0, yi = 0, xr = 0, xi = 0;
+
+        /* Settle the allpass state before measuring */
+        for (int i = start - 32; i < start; i++)
+            bench_read(x + i, dt, &ap, interp);
+
+        for (int i = start; i < RESP_LEN; i++) {
+            double y = bench_read(x + i, dt, &ap, interp);
+            yr += y * cos(w * i);
+            yi -= y * sin(w * i);
+            xr += x[i] * cos(w * i);
+            xi -= x[i] * sin(w * i);
+        }
+
+        /* H = Y / X, compared with exp(-j w dt) */
+        double den = xr * xr + xi * xi;
+        double hr = (yr * xr + yi * xi) / den;
+        double hi = (yi * xr - yr * xi) / den;
+        double mag = 20.0 * log10(sqrt(hr * hr + hi * hi));
+        double er = hr * cos(w * dt) - hi * sin(w * dt);
+        double ei = hr * sin(w * dt) + hi * cos(w * dt);
+        double derr = -atan2(ei, er) / w;
+
+        if (fabs(mag) > fabs(*mag_err_db)) *mag_err_db = mag;
+        if (fabs(derr) > fabs(*delay_err)) *delay_err = derr;
+    }
+    return bin * DEFAULT_SAMPLE_RATE / len;
+}
+
+static void bench_interp_response(void) {
+    static const double freqs[] = { 1000.0, 5000.0, 10000.0, 15000.0 };
+
+    for (int q = 0; q < 3; q++) {
+        for (size_t f = 0; f < sizeof(freqs) / sizeof(freqs[0]); f++) {
+            double mag, derr;
+            double hz = interp_response(q, freqs[f], &mag, &derr);
+            printf(",\n    {\"name\":\"interp_response\",\"quality\":\"%s\","
+                   "\"freq_hz\":%.0f,\"delay_ms\":[%.2f,%.2f],"
+                   "\"max_mag_err_db\":%.3f,\"max_delay_err_samples\":%.4f}",
+                   quality_names[q], hz, DELAY_MIN_SEC * 1e3,
+                   DELAY_MAX_SEC * 1e3, mag, derr);
+        }
+    }
+}
+
+static void run_lfo_fill(void *ctx, int n) {
+    lfo_t *l = (lfo_t *)ctx;
+    for (int i = 0; i < n; i += JC_CHUNK)
+        lfo_fill(l, g_out + i, JC_CHUNK);
+    g_sink = g_out[0];
+}
+
+/* --- Full block benchmark --- */
+
+/*
+ * process_block works in place, so with src set the input is restored
+ * before every block. Feeding the output back in instead decays to
+ * silence in some modes, and the instance then times its idle path.
+ */
+typedef struct {
+    void *inst;
+    int16_t *buf;
+    float *fbuf;
+    const int16_t *src;     /* NULL: the buffer is already silence */
+    const float *fsrc;
+    int frames;
+} block_ctx_t;
+
+static void fill_audio(int16_t *buf, int frames) {
+    uint32_t rng = 12345;
+    for (int i = 0; i < frames * 2; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        buf[i] = (int16_t)((int32_t)(rng >> 16) - 32768) / 4;
+    }
+}
+
+/* Noise input for the largest block size; smaller blocks use a prefix */
+#define BENCH_MAX_FRAMES 1024
+static int16_t g_src[BENCH_MAX_FRAMES * 2];
+static float   g_fsrc[BENCH_MAX_FRAMES * 2];
+
+static void run_block(void *ctx, int blocks) {
+    block_ctx_t *b = (block_ctx_t *)ctx;
+    size_t bytes = (size_t)b->frames * 2 * sizeof(int16_t);
+    for (int i = 0; i < blocks; i++) {
+        if (b->src) memcpy(b->buf, b->src, bytes);
+        g_fx_api_v2.process_block(b->inst, b->buf, b->frames);
+    }
+}
+
+static void run_block_f32(void *ctx, int blocks) {
+    block_ctx_t *b = (block_ctx_t *)ctx;
+    size_t bytes = (size_t)b->frames * 2 * sizeof(float);
+    for (int i = 0; i < blocks; i++) {
+        if (b->fsrc) memcpy(b->fbuf, b->fsrc, bytes);
+        g_fx_api_v3.process_block_f32(b->inst, b->fbuf, b->frames);
+    }
+}
+
+static void bench_process_block(void) {
+    static const int sizes[] = { 16, 32, 64, 128, 1024 };
+    static const char *mixes[] = { "0", "1" };
+
+    for (int m = 0; m < 3; m++) {
+        for (int x = 0; x < 2; x++) {
+            for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+                block_ctx_t b;
+                b.frames = sizes[s];
+                b.buf = (int16_t *)malloc((size_t)b.frames * 2 * sizeof(int16_t));
+                b.fbuf = (float *)malloc((size_t)b.frames * 2 * sizeof(float));
+                b.src = g_src;
+                b.fsrc = g_fsrc;
+                b.inst = g_fx_api_v2.create_instance(".", NULL);
+                g_fx_api_v2.set_param(b.inst, "mode", mode_names[m]);
+                g_fx_api_v2.set_param(b.inst, "mix", mixes[x]);
+
+                int blocks = BENCH_SAMPLES / b.frames;
+                if (blocks < 1) blocks = 1;
+
+                char extra[128];
+                snprintf(extra, sizeof(extra),
+                         "\"mode\":\"%s\",\"mix\":%s,\"block\":%d",
+                         mode_names[m], mixes[x], b.frames);
+                bench_report("process_block", extra, run_block, &b, blocks, b.frames);
+                bench_report("process_block_f32", extra, run_block_f32, &b, blocks, b.frames);
+
+                g_fx_api_v2.destroy_instance(b.inst);
+                free(b.buf);
+                free(b.fbuf);
+            }
+        }
+    }
+}
+
+/* Silent input at the host block size: the idle fast path once drained */
+static void bench_silence(void) {
+    for (int m = 0; m < 3; m++) {
+        block_ctx_t b;
+        b.frames = JC_CHUNK;
+        b.buf = (int16_t *)calloc((size_t)b.frames * 2, sizeof(int16_t));
+        b.fbuf = (float *)calloc((size_t)b.frames * 2, sizeof(float));
+        b.src = NULL;
+        b.fsrc = NULL;
+        b.inst = g_fx_api_v2.create_instance(".", NULL);
+        g_fx_api_v2.set_param(b.inst, "mode", mode_names[m]);
+
+        char extra[128];
+        snprintf(extra, sizeof(extra),
+                 "\"mode\":\"%s\",\"mix\":0.5,\"block\":%d,\"input\":\"silence\"",
+                 mode_names[m], b.frames);
+        bench_report("process_block", extra, run_block, &b,
+                     BENCH_SAMPLES / b.frames, b.frames);
+        bench_report("process_block_f32", extra, run_block_f32, &b,
+                     BENCH_SAMPLES / b.frames, b.frames);
+
+        g_fx_api_v2.destroy_instance(b.inst);
+        free(b.buf);
+        free(b.fbuf);
+    }
+}
+
+/* One setting of an enum param in mode m at the host block size; returns ns per sample */
+static double bench_setting(int m, const char *key, const char *val) {
+    block_ctx_t b;
+    b.frames = JC_CHUNK;
+    b.buf = (int16_t *)malloc((size_t)b.frames * 2 * sizeof(int16_t));
+    b.fbuf = NULL;
+    b.src = g_src;
+    b.fsrc = NULL;
+    b.inst = g_fx_api_v2.create_instance(".", NULL);
+    g_fx_api_v2.set_param(b.inst, "mode", mode_names[m]);
+    g_fx_api_v2.set_param(b.inst, "mix", "1");
+    g_fx_api_v2.set_param(b.inst, key, val);
+
+    char extra[128];
+    snprintf(extra, sizeof(extra),
+             "\"mode\":\"%s\",\"mix\":1,\"block\":%d,\"%s\":\"%s\"",
+             mode_names[m], b.frames, key, val);
+    double ns = bench_report("process_block", extra, run_block, &b,
+                             BENCH_SAMPLES / b.frames, b.frames);
+
+    g_fx_api_v2.destroy_instance(b.inst);
+    free(b.buf);
+    return ns;
+}
+
+/*
+ * The settings of one enum param against each other, per mode, at the
+ * host block size (half_rate off/on, quality tiers)
+ */
+static void bench_variants(const char *key, const char *const names[], int count) {
+    for (int m = 0; m < 3; m++)
+        for (int h = 0; h < count; h++)
+            bench_setting(m, key, names[h]);
+}
+
+/*
+ * Per-instance CPU budget of the bbd model: share of one Move core
+ * (Cortex-A72 at BBD_TARGET_MHZ) at 44.1 kHz, about 340 cycles per
+ * sample
+ */
+#define BBD_BUDGET_PCT 1.0
+#define BBD_TARGET_MHZ 1500.0
+
+/*
+ * ideal against bbd per mode, then a bbd_budget row with the bbd cost
+ * as a multiple of ideal and its core share against BBD_BUDGET_PCT.
+ * The share is of the core running the bench. Only an aarch64 run
+ * measures the budget; anywhere else the row is marked as an estimate,
+ * which holds only if the A72 needs no more time per sample than this
+ * core. No A72 figure has been recorded yet.
+ */
+static void bench_model(void) {
+    const double budget_cycles = BBD_BUDGET_PCT * 1e-2 * BBD_TARGET_MHZ * 1e6 /
+                                 DEFAULT_SAMPLE_RATE;
+#if defined(__aarch64__)
+    const char *basis = "measured";
+#else
+    const char *basis = "estimate";
+#endif
+
+    for (int m = 0; m < 3; m++) {
+        double ideal = bench_setting(m, "model", model_names[JC_MODEL_IDEAL]);
+        double bbd = bench_setting(m, "model", model_names[JC_MODEL_BBD]);
+        double pct = bbd * DEFAULT_SAMPLE_RATE * 1e-7;
+        printf(",\n    {\"name\":\"bbd_budget\",\"mode\":\"%s\",\"mix\":1,\"block\":%d,"
+               "\"ratio_to_ideal\":%.2f,\"cpu_pct\":%.4f,\"budget_pct\":%.1f,"
+               "\"budget_cycles\":%.0f,\"basis\":\"%s\",\"within_budget\":%s}",
+               mode_names[m], JC_CHUNK, bbd / ideal, pct, BBD_BUDGET_PCT,
+               budget_cycles, basis, pct <= BBD_BUDGET_PCT ? "true" : "false");
+    }
+}
+
+/*
+ * Every process kernel this CPU supports, the selected one included,
+ * per mode for each engine
+ */
+static void bench_kernels(void) {
+    for (int k = 0; k < JC_NUM_KERNELS; k++) {
+        const jc_kernel_t *kern = JC_KERNELS[k];
+        if (!kern->supported()) continue;
+
+        for (int e = 0; e < 2; e++) {
+            for (int m = 0; m < 3; m++) {
+                block_ctx_t b;
+                b.frames = JC_CHUNK;
+                b.buf = (int16_t *)malloc((size_t)b.frames * 2 * sizeof(int16_t));
+                b.fbuf = NULL;
+                b.src = g_src;
+                b.fsrc = NULL;
+                b.inst = g_fx_api_v2.create_instance(".", NULL);
+                g_fx_api_v2.set_param(b.inst, "mode", mode_names[m]);
+                g_fx_api_v2.set_param(b.inst, "mix", "1");
+                g_fx_api_v2.set_param(b.inst, "engine", engine_names[e]);
+
+                /* Swap the kernel and republish its tap stages */
+                jc_instance_t *inst = (jc_instance_t *)b.inst;
+                jc_bind_kernel(inst, kern);
+                jc_update_params(inst);
+
+                char extra[160];
+                snprintf(extra, sizeof(extra),
+                         "\"mode\":\"%s\",\"mix\":1,\"block\":%d,\"engine\":\"%s\","
+                         "\"kernel\":\"%s\",\"selected\":%s",
+                         mode_names[m], b.frames, engine_names[e], kern->name,
+                         kern == g_kernel ? "true" : "false");
+                bench_report("process_block", extra, run_block, &b,
+                             BENCH_SAMPLES / b.frames, b.frames);
+
+                g_fx_api_v2.destroy_instance(b.inst);
+                free(b.buf);
+            }
+        }
+    }
+}
+
+/* --- Batched instances --- */
+
+#define BATCH_MAX 16
+
+typedef struct {
+    void *inst[BATCH_MAX];
+    int16_t *buf[BATCH_MAX];
+    int count;
+} batch_ctx_t;
+
+static void run_serial(void *ctx, int blocks) {
+    batch_ctx_t *b = (batch_ctx_t *)ctx;
+    for (int i = 0; i < blocks; i++)
+        for (int j = 0; j < b->count; j++)
+            g_fx_api_v4.process_block(b->inst[j], b->buf[j], JC_CHUNK);
+}
+
+static void run_batched(void *ctx, int blocks) {
+    batch_ctx_t *b = (batch_ctx_t *)ctx;
+    for (int i = 0; i < blocks; i++)
+        g_fx_api_v4.process_blocks_batched(b->inst, b->buf, b->count, JC_CHUNK);
+}
+
+/*
+ * 1-16 instances (mode I+II, mix 0.5) one process_block at a time
+ * against one process_blocks_batched call; ns_per_sample is per
+ * instance, so a flat curve means no gain from batching.
+ */
+static void bench_batch(void) {
+    static const int counts[] = { 1, 2, 3, 4, 8, 16 };
+
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        batch_ctx_t b;
+        b.count = counts[c];
+        for (int j = 0; j < b.count; j++) {
+            b.inst[j] = g_fx_api_v4.create_instance(".", NULL);
+            g_fx_api_v4.set_param(b.inst[j], "mode", "I+II");
+            b.buf[j] = (int16_t *)malloc(JC_CHUNK * 2 * sizeof(int16_t));
+            fill_audio(b.buf[j], JC_CHUNK);
+        }
+
+        char extra[128];
+        snprintf(extra, sizeof(extra),
+                 "\"mode\":\"I+II\",\"mix\":0.5,\"block\":%d,\"instances\":%d",
+                 JC_CHUNK, b.count);
+        bench_report("serial", extra, run_serial, &b,
+                     BENCH_SAMPLES / JC_CHUNK, JC_CHUNK * b.count);
+        bench_report("batched", extra, run_batched, &b,
+                     BENCH_SAMPLES / JC_CHUNK, JC_CHUNK * b.count);
+
+        for (int j = 0; j < b.count; j++) {
+            g_fx_api_v4.destroy_instance(b.inst[j]);
+            free(b.buf[j]);
+        }
+    }
+}
+
+/* --- Engine accuracy --- */
+
+#define THD_LEN    8192
+#define THD_WARMUP 64      /* blocks before capture, past the filter settle */
+#define THD_BAND   50.0    /* Hz either side of the tone kept as signal */
+
+/*
+ * THD+N (dB) of the left channel: everything outside THD_BAND of
+ * freq_hz against what is inside, from a Hann-windowed DFT. The band
+ * keeps the chorus pitch modulation sidebands as signal. DC is
+ * excluded.
+ */
+static double thdn_db(const int16_t *io, double freq_hz) {
+    static double x[THD_LEN];
+    double total = 0.0;
+    double mean = 0.0;
+
+    for (int i = 0; i < THD_LEN; i++) mean += io[i * 2];
+    mean /= THD_LEN;
+    for (int i = 0; i < THD_LEN; i++) {
+        double w = 0.5 - 0.5 * cos(2.0 * M_PI * i / THD_LEN);
+        x[i] = (io[i * 2] - mean) * w;
+        total += x[i] * x[i];
+    }
+    total *= THD_LEN;  /* Parseval: sum over all bins of |X|^2 */
+
+    const double hz_per_bin = DEFAULT_SAMPLE_RATE / THD_LEN;
+    int lo = (int)((freq_hz - THD_BAND) / hz_per_bin);
+    int hi = (int)((freq_hz + THD_BAND) / hz_per_bin) + 1;
+    double band = 0.0;
+    for (int k = lo; k <= hi; k++) {
+        double re = 0.0, im = 0.0;
+        double w = 2.0 * M_PI * k / THD_LEN;
+        for (int i = 0; i < THD_LEN; i++) {
+            re += x[i] * cos(w * i);
+            im -= x[i] * sin(w * i);
+        }
+        band += 2.0 * (re * re + im * im);  /* positive and negative bin */
+    }
+    return 10.0 * log10((total - band) / band);
+}
+
+/*
+ * Float and fixed-point engines on the same 1 kHz, -6 dBFS tone: the
+ * THD+N of each and the fixed engine's deviation from float in output
+ * LSBs (tests/test_engines.c holds it to the tolerance).
+ */
+static void bench_engine_accuracy(void) {
+    static const char *mixes[] = { "0.5", "1" };
+    static int16_t out[2][THD_LEN * 2];
+    const double freq_hz = 1000.0;
+
+    for (int x = 0; x < 2; x++) {
+        void *inst[2];
+        for (int e = 0; e < 2; e++) {
+            inst[e] = g_fx_api_v2.create_instance(".", NULL);
+            g_fx_api_v2.set_param(inst[e], "mode", "I");
+            g_fx_api_v2.set_param(inst[e], "mix", mixes[x]);
+            g_fx_api_v2.set_param(inst[e], "engine", engine_names[e]);
+        }
+
+        int max_diff = 0;
+        double err2 = 0.0;
+        int16_t buf[2][JC_CHUNK * 2];
+        for (int blk = 0; blk < THD_WARMUP + THD_LEN / JC_CHUNK; blk++) {
+            for (int i = 0; i < JC_CHUNK; i++) {
+                double t = (double)(blk * JC_CHUNK + i) / DEFAULT_SAMPLE_RATE;
+                int16_t v = (int16_t)lrint(16384.0 * sin(2.0 * M_PI * freq_hz * t));
+                buf[0][i * 2] = buf[0][i * 2 + 1] = v;
+                buf[1][i * 2] = buf[1][i * 2 + 1] = v;
+            }
+            for (int e = 0; e < 2; e++)
+                g_fx_api_v2.process_block(inst[e], buf[e], JC_CHUNK);
+            if (blk < THD_WARMUP) continue;
+
+            int at = (blk - THD_WARMUP) * JC_CHUNK * 2;
+            for (int i = 0; i < JC_CHUNK * 2; i++) {
+                int d = abs(buf[1][i] - buf[0][i]);
+                if (d > max_diff) max_diff = d;
+                err2 += (double)d * d;
+                out[0][at + i] = buf[0][i];
+                out[1][at + i] = buf[1][i];
+            }
+        }
+
+        double rms = sqrt(err2 / (THD_LEN * 2)) / 32768.0;
+        for (int e = 0; e < 2; e++) {
+            printf(",\n    {\"name\":\"engine_accuracy\",\"engine\":\"%s\","
+                   "\"mode\":\"I\",\"mix\":%s,\"freq_hz\":%.0f,\"level_dbfs\":-6,"
+                   "\"thdn_db\":%.2f",
+                   engine_names[e], mixes[x], freq_hz, thdn_db(out[e], freq_hz));
+            if (e == JC_ENGINE_FIXED)
+                printf(",\"max_diff_lsb\":%d,\"rms_err_dbfs\":%.1f",
+                       max_diff, rms > 0.0 ? 20.0 * log10(rms) : -200.0);
+            printf("}");
+        }
+
+        for (int e = 0; e < 2; e++) g_fx_api_v2.destroy_instance(inst[e]);
+    }
+}
+
+int main(int argc, char **argv) {
+    int opt;
+    while ((opt = getopt(argc, argv, "qm:h")) != -1) {
+        switch (opt) {
+        case 'q': g_reps = 5; break;
+        case 'm': g_cpu_mhz = atof(optarg); break;
+        default:
+            fprintf(stderr, "usage: jc-bench [-q] [-m cpu_mhz]\n");
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+
+    move_audio_fx_init_v2(NULL);
+    move_audio_fx_init_v3(NULL);
+    move_audio_fx_init_v4(NULL);
+
+    uint32_t rng = 1;
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        g_in[i] = (float)(rng >> 8) / 8388608.0f - 1.0f;
+    }
+    fill_audio(g_src, BENCH_MAX_FRAMES);
+    for (int i = 0; i < BENCH_MAX_FRAMES * 2; i++) g_fsrc[i] = g_src[i] / 32768.0f;
+
+    printf("{\n  \"arch\":\"%s\",\n  \"cycle_source\":\"%s\",\n"
+           "  \"cpu_mhz\":%.0f,\n  \"sample_rate\":%.0f,\n  \"results\":[\n",
+#if defined(__aarch64__)
+           "aarch64",
+#elif defined(__x86_64__)
+           "x86_64",
+#else
+           "other",
+#endif
+           BENCH_HAVE_TSC ? "tsc" : "nominal_mhz", g_cpu_mhz, DEFAULT_SAMPLE_RATE);
+
+    fo_lpf_t f;
+    fo_lpf_init(&f);
+    f.alpha = fo_lpf_alpha(6000.0f, DEFAULT_SAMPLE_RATE);
+
+    delay_line_t dl;
+    if (delay_init(&dl, (int)(DELAY_MAX_SEC * DEFAULT_SAMPLE_RATE) + 2) != 0) return 1;
+    delay_write_block(&dl, g_in, dl.size);
+    delay_line_t *d = &dl;
+
+    lfo_t l;
+    lfo_init(&l, LFO_RATE_MHZ[0], (uint32_t)DEFAULT_SAMPLE_RATE);
+
+    bench_report("soft_limit",      "", run_soft_limit, NULL, BENCH_SAMPLES, 1);
+    bench_report("fast_sqrt",       "", run_fast_sqrt,  NULL, BENCH_SAMPLES, 1);
+    bench_report("fo_lpf_process",  "", run_fo_lpf,     &f,   BENCH_SAMPLES, 1);
+    bench_report("fo_lpf_block",    "", run_fo_lpf_block, &f, BENCH_SAMPLES, 1);
+    fo_lpf_t f2[2] = { f, f };
+    bench_report("fo_lpf_block_stereo", "", run_fo_lpf_block_stereo, f2, BENCH_SAMPLES, 1);
+    bench_report("delay_read_frac", "", run_delay_read, d,    BENCH_SAMPLES, 1);
+    bench_report("delay_read_hermite", "", run_delay_read_hermite, d, BENCH_SAMPLES, 1);
+    bench_report("delay_read_thiran",  "", run_delay_read_thiran,  d, BENCH_SAMPLES, 1);
+    bench_report("lfo_fill",        "", run_lfo_fill,   &l,   BENCH_SAMPLES, 1);
+    bench_process_block();
+    bench_silence();
+    bench_variants("half_rate", switch_names, 2);
+    bench_model();
+    bench_variants("quality", quality_names, 3);
+    bench_variants("engine", engine_names, 2);
+    bench_kernels();
+    bench_batch();
+    bench_interp_response();
+    bench_engine_accuracy();
+
+    printf("\n  ]\n}\n");
+    delay_free(d);
+    return 0;
+}
@@ -0,0 +1,192 @@
+/*
+ * Move Host - headless stand-in for the Move Anything runtime
+ *
+ * See move_host.h.
+ */
+
+#include <dlfcn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "move_host.h"
+
+/* Host callbacks without a context pointer route here */
+static move_host_t *g_current = NULL;
+
+/* --- host_api_v1_t callbacks --- */
+
+static void host_log(const char *msg) {
+    move_host_t *h = g_current;
+    if (!h || !msg) return;
+
+    int slot = h->log_count % MOVE_HOST_LOG_LINES;
+    snprintf(h->log_lines[slot], MOVE_HOST_LOG_LEN, "%s", msg);
+    h->log_count++;
+
+    if (h->verbose)
+        fprintf(stderr, "%s\n", msg);
+}
+
+static float host_get_bpm(void) {
+    return g_current ? g_current->bpm : 120.0f;
+}
+
+static int host_get_clock_status(void) {
+    return g_current ? g_current->clock_status : MOVE_CLOCK_STATUS_UNAVAILABLE;
+}
+
+static int host_midi_send(const uint8_t *msg, int len) {
+    (void)msg;
+    (void)len;
+    return 0;
+}
+
+static move_host_mod_event_t *mod_event_push(move_host_t *h) {
+    if (h->mod_count == h->mod_cap) {
+        int cap = h->mod_cap ? h->mod_cap * 2 : 64;
+        move_host_mod_event_t *ev = (move_host_mod_event_t *)
+            realloc(h->mod_events, (size_t)cap * sizeof(*ev));
+        if (!ev) return NULL;
+        h->mod_events = ev;
+        h->mod_cap = cap;
+    }
+    move_host_mod_event_t *e = &h->mod_events[h->mod_count++];
+    memset(e, 0, sizeof(*e));
+    return e;
+}
+
+static int host_mod_emit_value(void *ctx, const char *source_id,
+                               const char *target, const char *param,
+                               float signal, float depth, float offset,
+                               int bipolar, int enabled) {
+    move_host_t *h = (move_host_t *)ctx;
+    if (!h) return -1;
+    move_host_mod_event_t *e = mod_event_push(h);
+    if (!e) return -1;
+
+    snprintf(e->source_id, sizeof(e->source_id), "%s", source_id ? source_id : "");
+    snprintf(e->target, sizeof(e->target), "%s", target ? target : "");
+    snprintf(e->param, sizeof(e->param), "%s", param ? param : "");
+    e->signal  = signal;
+    e->depth   = depth;
+    e->offset  = offset;
+    e->bipolar = bipolar;
+    e->enabled = enabled;
+    return 0;
+}
+
+static void host_mod_clear_source(void *ctx, const char *source_id) {
+    move_host_t *h = (move_host_t *)ctx;
+    if (!h) return;
+    move_host_mod_event_t *e = mod_event_push(h);
+    if (!e) return;
+
+    e->cleared = 1;
+    snprintf(e->source_id, sizeof(e->source_id), "%s", source_id ? source_id : "");
+}
+
+/* --- Public API --- */
+
+int move_host_init(move_host_t *h, int sample_rate, int frames_per_block) {
+    if (!h) return -1;
+    memset(h, 0, sizeof(*h));
+
+    h->bpm          = 120.0f;
+    h->clock_status = MOVE_CLOCK_STATUS_STOPPED;
+
+    h->api.api_version        = MOVE_PLUGIN_API_VERSION;
+    h->api.sample_rate        = sample_rate > 0 ? sample_rate : MOVE_SAMPLE_RATE;
+    h->api.frames_per_block   = frames_per_block > 0 ? frames_per_block : MOVE_FRAMES_PER_BLOCK;
+    h->api.mapped_memory      = h->mailbox;
+    h->api.audio_out_offset   = MOVE_AUDIO_OUT_OFFSET;
+    h->api.audio_in_offset    = MOVE_AUDIO_IN_OFFSET;
+    h->api.log                = host_log;
+    h->api.midi_send_internal = host_midi_send;
+    h->api.midi_send_external = host_midi_send;
+    h->api.get_clock_status   = host_get_clock_status;
+    h->api.mod_emit_value     = host_mod_emit_value;
+    h->api.mod_clear_source   = host_mod_clear_source;
+    h->api.mod_host_ctx       = h;
+    h->api.get_bpm            = host_get_bpm;
+
+    g_current = h;
+    return 0;
+}
+
+void move_host_free(move_host_t *h) {
+    if (!h) return;
+    if (h->dl) dlclose(h->dl);
+    free(h->mod_events);
+    if (g_current == h) g_current = NULL;
+    memset(h, 0, sizeof(*h));
+}
+
+int move_host_load_fx(move_host_t *h, const char *so_path) {
+    if (!h || !so_path) return -1;
+
+    h->dl = dlopen(so_path, RTLD_NOW | RTLD_LOCAL);
+    if (!h->dl) {
+        fprintf(stderr, "move_host: dlopen %s: %s\n", so_path, dlerror());
+        return -1;
+    }
+
+    g_current = h;
+
+    audio_fx_api_v3_t *(*init_v3)(const host_api_v1_t *) =
+        (audio_fx_api_v3_t *(*)(const host_api_v1_t *))dlsym(h->dl, "move_audio_fx_init_v3");
+    if (init_v3) {
+        h->fx_v3 = init_v3(&h->api);
+        if (h->fx_v3 && h->fx_v3->api_version >= MOVE_HOST_AUDIO_FX_API_VERSION_3) {
+            /* v3 starts with the v2 layout */
+            h->fx = (audio_fx_api_v2_t *)h->fx_v3;
+            return 0;
+        }
+        h->fx_v3 = NULL;
+    }
+
+    audio_fx_api_v2_t *(*init)(const host_api_v1_t *) =
+        (audio_fx_api_v2_t *(*)(const host_api_v1_t *))dlsym(h->dl, "move_audio_fx_init_v2");
+    if (!init) {
+        fprintf(stderr, "move_host: %s: no move_audio_fx_init_v2\n", so_path);
+        return -1;
+    }
+
+    h->fx = init(&h->api);
+    if (!h->fx || h->fx->api_version < MOVE_HOST_AUDIO_FX_API_VERSION_2) {
+        fprintf(stderr, "move_host: %s: bad audio FX API\n", so_path);
+        h->fx = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+void *move_host_symbol(move_host_t *h, const char *name) {
+    if (!h || !h->dl) return NULL;
+    return dlsym(h->dl, name);
+}
+
+void move_host_process(move_host_t *h, void *instance, int16_t *audio_inout, int frames) {
+    if (!h || !h->fx) return;
+
+    size_t bytes = (size_t)frames * 2 * sizeof(int16_t);
+    if (bytes > MOVE_AUDIO_BYTES_PER_BLOCK) bytes = MOVE_AUDIO_BYTES_PER_BLOCK;
+
+    memcpy(h->mailbox + h->api.audio_in_offset, audio_inout, bytes);
+    h->fx->process_block(instance, audio_inout, frames);
+    memcpy(h->mailbox + h->api.audio_out_offset, audio_inout, bytes);
+}
+
+void move_host_process_f32(move_host_t *h, void *instance, float *audio_inout, int frames) {
+    if (!h || !h->fx_v3) return;
+    h->fx_v3->process_block_f32(instance, audio_inout, frames);
+}
+
+const char *move_host_last_log(const move_host_t *h) {
+    if (!h || h->log_count == 0) return "";
+    return h->log_lines[(h->log_count - 1) % MOVE_HOST_LOG_LINES];
+}
+
+void move_host_clear_mod_events(move_host_t *h) {
+    if (h) h->mod_count = 0;
+}
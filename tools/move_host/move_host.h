@@ -0,0 +1,121 @@
+/*
+ * Move Host - headless stand-in for the Move Anything runtime
+ *
+ * Fills in a host_api_v1_t (logging, tempo, clock status, modulation
+ * bus recorders and a fake mapped_memory mailbox), dlopens an audio FX
+ * module and drives it the way the chain host does: fixed-size
+ * interleaved int16 blocks at the host sample rate.
+ *
+ * Used for profiling and regression runs on a desktop Linux box.
+ * The host_api_v1_t callbacks without a context pointer (log, get_bpm,
+ * get_clock_status) route to the most recently initialized host, so
+ * only one move_host_t should be active per process.
+ */
+
+#ifndef MOVE_HOST_H
+#define MOVE_HOST_H
+
+#include <stdint.h>
+
+#include "plugin_api_v1.h"
+
+/* Audio FX API v2, as exported by move_audio_fx_init_v2() */
+#define MOVE_HOST_AUDIO_FX_API_VERSION_2 2
+
+typedef struct audio_fx_api_v2 {
+    uint32_t api_version;
+    void *(*create_instance)(const char *module_dir, const char *config_json);
+    void (*destroy_instance)(void *instance);
+    void (*process_block)(void *instance, int16_t *audio_inout, int frames);
+    void (*set_param)(void *instance, const char *key, const char *val);
+    int  (*get_param)(void *instance, const char *key, char *buf, int buf_len);
+} audio_fx_api_v2_t;
+
+/* Audio FX API v3: v2 plus interleaved float processing */
+#define MOVE_HOST_AUDIO_FX_API_VERSION_3 3
+
+typedef struct audio_fx_api_v3 {
+    uint32_t api_version;
+    void *(*create_instance)(const char *module_dir, const char *config_json);
+    void (*destroy_instance)(void *instance);
+    void (*process_block)(void *instance, int16_t *audio_inout, int frames);
+    void (*set_param)(void *instance, const char *key, const char *val);
+    int  (*get_param)(void *instance, const char *key, char *buf, int buf_len);
+    void (*process_block_f32)(void *instance, float *audio_inout, int frames);
+} audio_fx_api_v3_t;
+
+#define MOVE_HOST_MAILBOX_SIZE 4096
+#define MOVE_HOST_LOG_LINES    64
+#define MOVE_HOST_LOG_LEN      256
+#define MOVE_HOST_ID_LEN       64
+
+/* One recorded mod_emit_value() or mod_clear_source() call */
+typedef struct {
+    int   cleared;      /* 1 for mod_clear_source, 0 for mod_emit_value */
+    char  source_id[MOVE_HOST_ID_LEN];
+    char  target[MOVE_HOST_ID_LEN];
+    char  param[MOVE_HOST_ID_LEN];
+    float signal;
+    float depth;
+    float offset;
+    int   bipolar;
+    int   enabled;
+} move_host_mod_event_t;
+
+typedef struct move_host {
+    host_api_v1_t api;
+
+    /* Values reported through the host API */
+    float bpm;
+    int   clock_status;     /* MOVE_CLOCK_STATUS_* */
+    int   verbose;          /* echo plugin log lines to stderr */
+
+    /* Fake SPI mailbox behind api.mapped_memory */
+    uint8_t mailbox[MOVE_HOST_MAILBOX_SIZE];
+
+    /* Last MOVE_HOST_LOG_LINES plugin log lines (ring) */
+    char log_lines[MOVE_HOST_LOG_LINES][MOVE_HOST_LOG_LEN];
+    int  log_count;
+
+    /* Modulation bus recorder */
+    move_host_mod_event_t *mod_events;
+    int mod_count;
+    int mod_cap;
+
+    /* Loaded module; fx_v3 is set (and aliases fx) if the module has v3 */
+    void *dl;
+    audio_fx_api_v2_t *fx;
+    audio_fx_api_v3_t *fx_v3;
+} move_host_t;
+
+/* Set up host API tables; returns 0 on success */
+int  move_host_init(move_host_t *h, int sample_rate, int frames_per_block);
+
+/* Unload the module and free recorder storage */
+void move_host_free(move_host_t *h);
+
+/*
+ * dlopen an audio FX .so and initialize it through
+ * move_audio_fx_init_v3() if exported, else move_audio_fx_init_v2()
+ */
+int  move_host_load_fx(move_host_t *h, const char *so_path);
+
+/* Resolve an extra symbol from the loaded module (NULL if absent) */
+void *move_host_symbol(move_host_t *h, const char *name);
+
+/*
+ * Run one block through process_block, staging it through the
+ * mailbox audio-in area and copying the result to audio-out, as the
+ * real host does.
+ */
+void move_host_process(move_host_t *h, void *instance, int16_t *audio_inout, int frames);
+
+/* Float variant of move_host_process; requires fx_v3 */
+void move_host_process_f32(move_host_t *h, void *instance, float *audio_inout, int frames);
+
+/* Most recent log line, or "" if nothing was logged */
+const char *move_host_last_log(const move_host_t *h);
+
+void move_host_clear_mod_events(move_host_t *h);
+
+#endif /* MOVE_HOST_H */
@@ -0,0 +1,216 @@
+/*
+ * move-host - run an audio FX module on a desktop Linux box
+ *
+ * Loads a module .so through the Move Host stand-in, creates one
+ * instance, applies parameters and streams blocks through it.
+ * Input is a test signal or raw interleaved s16le stereo; output can
+ * be written as raw s16le for diffing or listening.
+ *
+ *   move-host [options] module.so
+ *     -r RATE      host sample rate (44100)
+ *     -b FRAMES    frames per block (128)
+ *     -n BLOCKS    blocks to run when generating input (345, ~1 s)
+ *     -s SIGNAL    sine | noise | silence (sine)
+ *     -i FILE      raw s16le stereo input (overrides -s/-n)
+ *     -o FILE      raw s16le stereo output
+ *     -p KEY=VAL   set_param before running (repeatable)
+ *     -g KEY       print get_param after running (repeatable)
+ *     -f           process through process_block_f32 (API v3)
+ *     -v           echo module log lines to stderr
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "move_host.h"
+
+#define MAX_ARGS 32
+
+static void usage(void) {
+    fprintf(stderr,
+        "usage: move-host [-r rate] [-b frames] [-n blocks] [-s sine|noise|silence]\n"
+        "                 [-i in.raw] [-o out.raw] [-p key=val]... [-g key]... [-f] [-v]\n"
+        "                 module.so\n");
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void gen_block(const char *signal, int16_t *buf, int frames,
+                      long frame0, int rate, uint32_t *rng) {
+    for (int i = 0; i < frames; i++) {
+        float l = 0.0f, r = 0.0f;
+        if (strcmp(signal, "sine") == 0) {
+            double t = (double)(frame0 + i) / rate;
+            l = 0.5f * (float)sin(2.0 * M_PI * 440.0 * t);
+            r = 0.5f * (float)sin(2.0 * M_PI * 660.0 * t);
+        } else if (strcmp(signal, "noise") == 0) {
+            *rng = *rng * 1664525u + 1013904223u;
+            l = ((float)(*rng >> 8) / 16777216.0f - 0.5f);
+            *rng = *rng * 1664525u + 1013904223u;
+            r = ((float)(*rng >> 8) / 16777216.0f - 0.5f);
+        }
+        buf[i * 2]     = (int16_t)(l * 32767.0f);
+        buf[i * 2 + 1] = (int16_t)(r * 32767.0f);
+    }
+}
+
+int main(int argc, char **argv) {
+    int rate = MOVE_SAMPLE_RATE;
+    int frames = MOVE_FRAMES_PER_BLOCK;
+    long blocks = 345;
+    const char *signal = "sine";
+    const char *in_path = NULL;
+    const char *out_path = NULL;
+    const char *params[MAX_ARGS];
+    const char *gets[MAX_ARGS];
+    int n_params = 0, n_gets = 0, verbose = 0, use_f32 = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "r:b:n:s:i:o:p:g:fvh")) != -1) {
+        switch (opt) {
+        case 'r': rate = atoi(optarg); break;
+        case 'b': frames = atoi(optarg); break;
+        case 'n': blocks = atol(optarg); break;
+        case 's': signal = optarg; break;
+        case 'i': in_path = optarg; break;
+        case 'o': out_path = optarg; break;
+        case 'p': if (n_params < MAX_ARGS) params[n_params++] = optarg; break;
+        case 'g': if (n_gets < MAX_ARGS) gets[n_gets++] = optarg; break;
+        case 'f': use_f32 = 1; break;
+        case 'v': verbose = 1; break;
+        default: usage(); return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (optind != argc - 1 || frames <= 0 || rate <= 0) {
+        usage();
+        return 2;
+    }
+
+    move_host_t *host = (move_host_t *)malloc(sizeof(move_host_t));
+    if (!host) return 1;
+    move_host_init(host, rate, frames);
+    host->verbose = verbose;
+    if (move_host_load_fx(host, argv[optind]) != 0) {
+        move_host_free(host);
+        free(host);
+        return 1;
+    }
+    if (use_f32 && !host->fx_v3) {
+        fprintf(stderr, "move-host: module has no process_block_f32\n");
+        move_host_free(host);
+        free(host);
+        return 1;
+    }
+
+    void *inst = host->fx->create_instance(".", NULL);
+    if (!inst) {
+        fprintf(stderr, "move-host: create_instance failed\n");
+        move_host_free(host);
+        free(host);
+        return 1;
+    }
+
+    for (int i = 0; i < n_params; i++) {
+        char key[128];
+        const char *eq = strchr(params[i], '=');
+        if (!eq || (size_t)(eq - params[i]) >= sizeof(key)) {
+            fprintf(stderr, "move-host: bad -p %s\n", params[i]);
+            continue;
+        }
+        memcpy(key, params[i], (size_t)(eq - params[i]));
+        key[eq - params[i]] = '\0';
+        host->fx->set_param(inst, key, eq + 1);
+    }
+
+    /* Failures from here on still release the instance and host below */
+    int rc = 0;
+    FILE *fin = NULL, *fout = NULL;
+    if (in_path && !(fin = fopen(in_path, "rb"))) {
+        perror(in_path);
+        rc = 1;
+    }
+    if (rc == 0 && out_path && !(fout = fopen(out_path, "wb"))) {
+        perror(out_path);
+        rc = 1;
+    }
+
+    int16_t *buf = (int16_t *)calloc((size_t)frames * 2, sizeof(int16_t));
+    float *fbuf = (float *)calloc((size_t)frames * 2, sizeof(float));
+    if (rc == 0 && (!buf || !fbuf)) {
+        fprintf(stderr, "move-host: out of memory\n");
+        rc = 1;
+    }
+    uint32_t rng = 1;
+    long total = 0;
+    double peak = 0.0, sum_sq = 0.0, busy = 0.0;
+
+    for (long b = 0; rc == 0 && (fin || b < blocks); b++) {
+        int n = frames;
+        if (fin) {
+            size_t got = fread(buf, 2 * sizeof(int16_t), (size_t)frames, fin);
+            if (got == 0) break;
+            n = (int)got;
+        } else {
+            gen_block(signal, buf, n, total, rate, &rng);
+        }
+
+        double t0 = now_sec();
+        if (use_f32) {
+            for (int i = 0; i < n * 2; i++) fbuf[i] = buf[i] / 32768.0f;
+            t0 = now_sec();
+            move_host_process_f32(host, inst, fbuf, n);
+            busy += now_sec() - t0;
+            for (int i = 0; i < n * 2; i++) {
+                float v = fbuf[i];
+                if (v > 1.0f) v = 1.0f;
+                if (v < -1.0f) v = -1.0f;
+                buf[i] = (int16_t)(v * 32767.0f);
+            }
+        } else {
+            move_host_process(host, inst, buf, n);
+            busy += now_sec() - t0;
+        }
+
+        for (int i = 0; i < n * 2; i++) {
+            double s = buf[i] / 32768.0;
+            if (fabs(s) > peak) peak = fabs(s);
+            sum_sq += s * s;
+        }
+        if (fout) fwrite(buf, 2 * sizeof(int16_t), (size_t)n, fout);
+        total += n;
+    }
+
+    if (rc == 0) {
+        double audio_sec = (double)total / rate;
+        printf("frames:    %ld (%.3f s)\n", total, audio_sec);
+        printf("peak:      %.2f dBFS\n", peak > 0.0 ? 20.0 * log10(peak) : -INFINITY);
+        printf("rms:       %.2f dBFS\n",
+               total > 0 && sum_sq > 0.0 ? 10.0 * log10(sum_sq / (2.0 * total)) : -INFINITY);
+        printf("dsp time:  %.3f ms (%.1fx realtime)\n", busy * 1e3,
+               busy > 0.0 ? audio_sec / busy : 0.0);
+        printf("log lines: %d, mod events: %d\n", host->log_count, host->mod_count);
+
+        for (int i = 0; i < n_gets; i++) {
+            char val[1024];
+            int len = host->fx->get_param(inst, gets[i], val, sizeof(val));
+            printf("%s = %s\n", gets[i], len >= 0 ? val : "(unset)");
+        }
+    }
+
+    free(buf);
+    free(fbuf);
+    if (fin) fclose(fin);
+    if (fout) fclose(fout);
+    host->fx->destroy_instance(inst);
+    move_host_free(host);
+    free(host);
+    return rc;
+}
@@ -0,0 +1,809 @@
+/*
+ * jc-render - render WAV files through an audio FX module offline
+ *
+ * Loads a module .so through the Move Host stand-in and streams a WAV
+ * file through one instance, block by block, into a new WAV file. The
+ * input is memory-mapped and read sequentially, with pages behind the
+ * read position dropped again; output is written as it is produced.
+ * Memory use is therefore a few blocks regardless of file length.
+ *
+ *   jc-render [options] -i in.wav -o out.wav module.so
+ *     -b FRAMES    frames per process call (128)
+ *     -t FORMAT    output sample format: 16 | 24 | 32f (input's)
+ *     -p KEY=VAL   set_param before rendering (repeatable)
+ *     -a KEY=ENV   automate KEY; ENV is T:V[,T:V...], T in seconds
+ *                  (repeatable)
+ *     -j FILE      JSON sidecar with "params" and "automation"
+ *     -P PATH      s16 | f32 | auto: process_block or process_block_f32
+ *     -T           append the module's tail (get_param tail_samples)
+ *     -v           echo module log lines to stderr
+ *
+ * Input is 16- or 24-bit PCM or 32-bit float WAV, mono or stereo; mono
+ * is fed to both channels and output is always stereo, at the input
+ * rate (which is also the host rate the module sees).
+ *
+ * The sidecar looks like
+ *
+ *   { "params":     { "mode": "I+II", "mix": 0.7 },
+ *     "automation": { "mix": [[0, 0], [2.5, 1]], "mode": [[0, "I"], [8, "II"]] } }
+ *
+ * Command-line -p and -a override sidecar entries for the same key.
+ * Numeric envelopes are interpolated linearly, others step; values are
+ * sent at block boundaries, and only when they change, leaving the
+ * module's own smoothing to fill in between.
+ *
+ * The auto path uses process_block when both files are 16-bit, so the
+ * result is what the Move would produce, and process_block_f32 (if the
+ * module has it) otherwise, so 24-bit and float sources are not
+ * truncated to 16 bits on the way through.
+ */
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "move_host.h"
+
+#define MAX_ARGS      32
+#define MAX_ENVS      16
+#define VAL_LEN       64
+
+/* Input pages behind the read position are dropped in steps of this */
+#define DROP_BYTES    (8u << 20)
+
+/* Sample formats */
+#define FMT_S16 0
+#define FMT_S24 1
+#define FMT_F32 2
+
+static const char *fmt_names[3] = { "16", "24", "32f" };
+static const int   fmt_bytes[3] = { 2, 3, 4 };
+
+static void usage(void) {
+    fprintf(stderr,
+        "usage: jc-render [-b frames] [-t 16|24|32f] [-p key=val]... [-a key=t:v,...]...\n"
+        "                 [-j sidecar.json] [-P s16|f32|auto] [-T] [-v]\n"
+        "                 -i in.wav -o out.wav module.so\n");
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int parse_fmt(const char *s) {
+    for (int i = 0; i < 3; i++)
+        if (strcmp(s, fmt_names[i]) == 0) return i;
+    return -1;
+}
+
+/* --- WAV input (memory-mapped) --- */
+
+typedef struct {
+    const uint8_t *map;
+    size_t map_len;
+    const uint8_t *data;    /* first frame */
+    long frames;
+    int channels;
+    int rate;
+    int format;             /* FMT_* */
+    size_t dropped;         /* bytes of map already released */
+} wav_in_t;
+
+static uint32_t rd_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint16_t rd_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+/* Returns 0 and fills w, or prints why the file is unusable */
+static int wav_open(wav_in_t *w, const char *path) {
+    memset(w, 0, sizeof(*w));
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < 12) {
+        fprintf(stderr, "jc-render: %s: not a WAV file\n", path);
+        close(fd);
+        return -1;
+    }
+    w->map_len = (size_t)st.st_size;
+    void *m = mmap(NULL, w->map_len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (m == MAP_FAILED) {
+        perror(path);
+        return -1;
+    }
+    w->map = (const uint8_t *)m;
+    madvise(m, w->map_len, MADV_SEQUENTIAL);
+
+    const uint8_t *p = w->map;
+    const uint8_t *end = w->map + w->map_len;
+    if (memcmp(p, "RIFF", 4) != 0 || memcmp(p + 8, "WAVE", 4) != 0) {
+        fprintf(stderr, "jc-render: %s: not a RIFF/WAVE file\n", path);
+        return -1;
+    }
+
+    int tag = -1, bits = 0, align = 0;
+    size_t data_len = 0;
+    for (p += 12; end - p >= 8; ) {
+        uint32_t len = rd_u32(p + 4);
+        const uint8_t *body = p + 8;
+        size_t avail = (size_t)(end - body);
+
+        if (memcmp(p, "fmt ", 4) == 0 && len >= 16 && avail >= 16) {
+            tag         = rd_u16(body);
+            w->channels = rd_u16(body + 2);
+            w->rate     = (int)rd_u32(body + 4);
+            align       = rd_u16(body + 12);
+            bits        = rd_u16(body + 14);
+            /* WAVE_FORMAT_EXTENSIBLE: the real tag leads the subformat GUID */
+            if (tag == 0xFFFE && len >= 40 && avail >= 40)
+                tag = rd_u16(body + 24);
+        } else if (memcmp(p, "data", 4) == 0) {
+            w->data = body;
+            data_len = len < avail ? len : avail;   /* truncated or streamed files */
+            break;
+        }
+        if (len > avail) break;
+        p = body + len + (len & 1);
+    }
+
+    if (tag == 1 && bits == 16)       w->format = FMT_S16;
+    else if (tag == 1 && bits == 24)  w->format = FMT_S24;
+    else if (tag == 3 && bits == 32)  w->format = FMT_F32;
+    else {
+        fprintf(stderr, "jc-render: %s: unsupported format (tag %d, %d bits); "
+                "need 16/24-bit PCM or 32-bit float\n", path, tag, bits);
+        return -1;
+    }
+    if (w->channels < 1 || w->channels > 2 || w->rate <= 0 ||
+        align != w->channels * fmt_bytes[w->format]) {
+        fprintf(stderr, "jc-render: %s: need mono or stereo at a valid rate\n", path);
+        return -1;
+    }
+    if (!w->data) {
+        fprintf(stderr, "jc-render: %s: no data chunk\n", path);
+        return -1;
+    }
+    w->frames = (long)(data_len / (size_t)align);
+    return 0;
+}
+
+static void wav_close(wav_in_t *w) {
+    if (w->map) munmap((void *)w->map, w->map_len);
+    w->map = NULL;
+}
+
+/* Sample k of frame f, channel c (mono repeats), as float or int16 */
+static float wav_get_f32(const wav_in_t *w, long f, int c) {
+    const uint8_t *p = w->data + ((size_t)f * w->channels + (size_t)(c % w->channels)) *
+                                 fmt_bytes[w->format];
+    switch (w->format) {
+    case FMT_S16: return (float)(int16_t)rd_u16(p) / 32768.0f;
+    case FMT_S24: return (float)((int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 |
+                                           (uint32_t)p[2] << 24) >> 8) / 8388608.0f;
+    default: {
+        float v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    }
+}
+
+static int16_t f32_to_s16(float v) {
+    if (v >  1.0f) v =  1.0f;
+    if (v < -1.0f) v = -1.0f;
+    return (int16_t)(v * 32767.0f);
+}
+
+static int16_t wav_get_s16(const wav_in_t *w, long f, int c) {
+    const uint8_t *p = w->data + ((size_t)f * w->channels + (size_t)(c % w->channels)) *
+                                 fmt_bytes[w->format];
+    switch (w->format) {
+    case FMT_S16: return (int16_t)rd_u16(p);
+    case FMT_S24: {
+        /* Round to 16 bits, saturating at the top */
+        int32_t v = (int32_t)((uint32_t)p[0] << 8 | (uint32_t)p[1] << 16 |
+                              (uint32_t)p[2] << 24) >> 8;
+        v = (v + 128) >> 8;
+        return (int16_t)(v > INT16_MAX ? INT16_MAX : v);
+    }
+    default: return f32_to_s16(wav_get_f32(w, f, c));
+    }
+}
+
+/* Release input pages before frame f; they are not read again */
+static void wav_drop_before(wav_in_t *w, long f) {
+    long page = sysconf(_SC_PAGESIZE);
+    size_t pos = (size_t)(w->data - w->map) +
+                 (size_t)f * (size_t)w->channels * (size_t)fmt_bytes[w->format];
+    size_t upto = pos / (size_t)page * (size_t)page;
+    if (upto - w->dropped < DROP_BYTES) return;
+    madvise((void *)(w->map + w->dropped), upto - w->dropped, MADV_DONTNEED);
+    w->dropped = upto;
+}
+
+/* --- WAV output (streamed, sizes patched at the end) --- */
+
+typedef struct {
+    FILE *f;
+    int format;
+    int rate;
+    long frames;
+    uint8_t *buf;           /* one block of encoded frames */
+} wav_out_t;
+
+static void wr_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); p[2] = (uint8_t)(v >> 16); p[3] = (uint8_t)(v >> 24);
+}
+
+static void wr_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8);
+}
+
+/*
+ * Stereo header: fmt (18 bytes for float, with a fact chunk), then
+ * data. Rewritten by wav_finish once the length is known.
+ */
+static size_t wav_header(uint8_t *h, int format, int rate, long frames) {
+    int is_float = format == FMT_F32;
+    int bytes = fmt_bytes[format];
+    uint32_t data_len = (uint32_t)((uint64_t)frames * 2 * (uint64_t)bytes);
+    uint32_t fmt_len = is_float ? 18 : 16;
+    size_t n = 0;
+
+    memcpy(h, "RIFF", 4);
+    memcpy(h + 8, "WAVE", 4);
+    memcpy(h + 12, "fmt ", 4);
+    wr_u32(h + 16, fmt_len);
+    wr_u16(h + 20, is_float ? 3 : 1);
+    wr_u16(h + 22, 2);
+    wr_u32(h + 24, (uint32_t)rate);
+    wr_u32(h + 28, (uint32_t)(rate * 2 * bytes));
+    wr_u16(h + 32, (uint16_t)(2 * bytes));
+    wr_u16(h + 34, (uint16_t)(bytes * 8));
+    n = 20 + fmt_len;
+    if (is_float) {
+        wr_u16(h + 36, 0);
+        memcpy(h + n, "fact", 4);
+        wr_u32(h + n + 4, 4);
+        wr_u32(h + n + 8, (uint32_t)frames);
+        n += 12;
+    }
+    memcpy(h + n, "data", 4);
+    wr_u32(h + n + 4, data_len);
+    n += 8;
+    wr_u32(h + 4, (uint32_t)(n - 8 + data_len));
+    return n;
+}
+
+static int wav_create(wav_out_t *w, const char *path, int format, int rate, int block) {
+    memset(w, 0, sizeof(*w));
+    w->format = format;
+    w->rate = rate;
+    w->buf = (uint8_t *)malloc((size_t)block * 2 * (size_t)fmt_bytes[format]);
+    if (!w->buf) return -1;
+    if (!(w->f = fopen(path, "wb"))) {
+        perror(path);
+        return -1;
+    }
+    uint8_t h[64];
+    size_t n = wav_header(h, format, rate, 0);
+    return fwrite(h, 1, n, w->f) == n ? 0 : -1;
+}
+
+static void put_sample(uint8_t *p, int format, float v) {
+    if (format == FMT_F32) {
+        memcpy(p, &v, sizeof(v));
+        return;
+    }
+    if (v >  1.0f) v =  1.0f;
+    if (v < -1.0f) v = -1.0f;
+    if (format == FMT_S16) {
+        wr_u16(p, (uint16_t)(int16_t)(v * 32767.0f));
+    } else {
+        int32_t s = (int32_t)lrintf(v * 8388607.0f);
+        p[0] = (uint8_t)s; p[1] = (uint8_t)(s >> 8); p[2] = (uint8_t)(s >> 16);
+    }
+}
+
+/* Append n interleaved stereo frames, from float or (if s16) int16 */
+static int wav_write(wav_out_t *w, const float *f32, const int16_t *s16, int n) {
+    int bytes = fmt_bytes[w->format];
+    for (int i = 0; i < n * 2; i++) {
+        uint8_t *p = w->buf + (size_t)i * bytes;
+        if (!s16)                        put_sample(p, w->format, f32[i]);
+        else if (w->format == FMT_S16)   wr_u16(p, (uint16_t)s16[i]);
+        else if (w->format == FMT_S24) { p[0] = 0; wr_u16(p + 1, (uint16_t)s16[i]); }
+        else                             put_sample(p, w->format, s16[i] / 32768.0f);
+    }
+    w->frames += n;
+    size_t len = (size_t)n * 2 * bytes;
+    return fwrite(w->buf, 1, len, w->f) == len ? 0 : -1;
+}
+
+static int wav_finish(wav_out_t *w) {
+    int rc = 0;
+    if (w->f) {
+        if ((uint64_t)w->frames * 2 * fmt_bytes[w->format] > 0xFFFFFFF0u)
+            fprintf(stderr, "jc-render: output exceeds 4 GiB; WAV sizes are wrong\n");
+        uint8_t h[64];
+        size_t n = wav_header(h, w->format, w->rate, w->frames);
+        if (fseek(w->f, 0, SEEK_SET) != 0 || fwrite(h, 1, n, w->f) != n) rc = -1;
+        if (fclose(w->f) != 0) rc = -1;
+    }
+    free(w->buf);
+    memset(w, 0, sizeof(*w));
+    return rc;
+}
+
+/* --- Parameters and automation --- */
+
+typedef struct {
+    double t;               /* seconds */
+    double v;               /* numeric value, if numeric */
+    int    numeric;
+    char   s[VAL_LEN];
+} env_point_t;
+
+typedef struct {
+    char key[VAL_LEN];
+    env_point_t *pts;
+    int n, cap;
+    char sent[VAL_LEN];     /* last value passed to set_param */
+} env_t;
+
+typedef struct {
+    char key[VAL_LEN];
+    char val[VAL_LEN];
+} param_t;
+
+static param_t g_params[MAX_ARGS];
+static int     g_n_params;
+static env_t   g_envs[MAX_ENVS];
+static int     g_n_envs;
+
+/* Later settings of a key replace earlier ones */
+static void param_set(const char *key, const char *val) {
+    int i = 0;
+    while (i < g_n_params && strcmp(g_params[i].key, key) != 0) i++;
+    if (i == MAX_ARGS) {
+        fprintf(stderr, "jc-render: too many parameters\n");
+        return;
+    }
+    snprintf(g_params[i].key, VAL_LEN, "%s", key);
+    snprintf(g_params[i].val, VAL_LEN, "%s", val);
+    if (i == g_n_params) g_n_params++;
+}
+
+/* Envelope for key, emptied if it exists */
+static env_t *env_reset(const char *key) {
+    int i = 0;
+    while (i < g_n_envs && strcmp(g_envs[i].key, key) != 0) i++;
+    if (i == MAX_ENVS) {
+        fprintf(stderr, "jc-render: too many automated parameters\n");
+        return NULL;
+    }
+    env_t *e = &g_envs[i];
+    if (i == g_n_envs) {
+        memset(e, 0, sizeof(*e));
+        snprintf(e->key, VAL_LEN, "%s", key);
+        g_n_envs++;
+    }
+    e->n = 0;
+    e->sent[0] = '\0';
+    return e;
+}
+
+static int env_add(env_t *e, double t, const char *val) {
+    if (e->n == e->cap) {
+        int cap = e->cap ? e->cap * 2 : 8;
+        env_point_t *p = (env_point_t *)realloc(e->pts, (size_t)cap * sizeof(*p));
+        if (!p) return -1;
+        e->pts = p;
+        e->cap = cap;
+    }
+    env_point_t *p = &e->pts[e->n];
+    char *end;
+    p->t = t;
+    p->v = strtod(val, &end);
+    p->numeric = end != val && *end == '\0';
+    snprintf(p->s, VAL_LEN, "%s", val);
+
+    /* Keep points in time order */
+    for (int i = e->n; i > 0 && e->pts[i - 1].t > t; i--) {
+        env_point_t tmp = e->pts[i];
+        e->pts[i] = e->pts[i - 1];
+        e->pts[i - 1] = tmp;
+    }
+    e->n++;
+    return 0;
+}
+
+/* Value at time t: linear between numeric points, else the last one reached */
+static void env_value(const env_t *e, double t, char *out) {
+    int k = 0;
+    while (k < e->n && e->pts[k].t <= t) k++;
+    if (k == 0) {
+        snprintf(out, VAL_LEN, "%s", e->pts[0].s);
+    } else if (k == e->n || !e->pts[k - 1].numeric || !e->pts[k].numeric) {
+        snprintf(out, VAL_LEN, "%s", e->pts[k - 1].s);
+    } else {
+        const env_point_t *a = &e->pts[k - 1], *b = &e->pts[k];
+        double x = (t - a->t) / (b->t - a->t);
+        snprintf(out, VAL_LEN, "%.6g", a->v + x * (b->v - a->v));
+    }
+}
+
+/* KEY=VAL from -p */
+static int parse_param_arg(const char *arg) {
+    char key[VAL_LEN];
+    const char *eq = strchr(arg, '=');
+    if (!eq || eq == arg || (size_t)(eq - arg) >= sizeof(key)) return -1;
+    memcpy(key, arg, (size_t)(eq - arg));
+    key[eq - arg] = '\0';
+    param_set(key, eq + 1);
+    return 0;
+}
+
+/* KEY=T:V,T:V,... from -a */
+static int parse_env_arg(const char *arg) {
+    char key[VAL_LEN];
+    const char *eq = strchr(arg, '=');
+    if (!eq || eq == arg || (size_t)(eq - arg) >= sizeof(key)) return -1;
+    memcpy(key, arg, (size_t)(eq - arg));
+    key[eq - arg] = '\0';
+
+    env_t *e = env_reset(key);
+    if (!e) return -1;
+    for (const char *p = eq + 1; *p; ) {
+        char *colon;
+        double t = strtod(p, &colon);
+        if (colon == p || *colon != ':') return -1;
+        const char *v = colon + 1;
+        size_t len = strcspn(v, ",");
+        char val[VAL_LEN];
+        if (len == 0 || len >= sizeof(val)) return -1;
+        memcpy(val, v, len);
+        val[len] = '\0';
+        if (env_add(e, t, val) != 0) return -1;
+        p = v + len + (v[len] == ',');
+    }
+    return e->n > 0 ? 0 : -1;
+}
+
+/* --- JSON sidecar --- */
+
+/*
+ * Just enough JSON for the sidecar: objects, arrays, strings without
+ * \u escapes, numbers and literals. Unknown keys are skipped.
+ */
+typedef struct {
+    const char *p;
+    int err;
+} json_t;
+
+static void json_ws(json_t *j) {
+    while (*j->p == ' ' || *j->p == '\t' || *j->p == '\n' || *j->p == '\r') j->p++;
+}
+
+static int json_eat(json_t *j, char c) {
+    json_ws(j);
+    if (*j->p != c) return 0;
+    j->p++;
+    return 1;
+}
+
+static void json_string(json_t *j, char *out, size_t cap) {
+    size_t n = 0;
+    if (!json_eat(j, '"')) { j->err = 1; return; }
+    while (*j->p && *j->p != '"') {
+        char c = *j->p++;
+        if (c == '\\' && *j->p) c = *j->p++;
+        if (n + 1 < cap) out[n++] = c;
+    }
+    if (!json_eat(j, '"')) j->err = 1;
+    out[n] = '\0';
+}
+
+/* String, number or literal as text */
+static void json_scalar(json_t *j, char *out, size_t cap) {
+    json_ws(j);
+    if (*j->p == '"') {
+        json_string(j, out, cap);
+        return;
+    }
+    size_t len = strcspn(j->p, ",]} \t\r\n");
+    if (len == 0 || len >= cap) { j->err = 1; return; }
+    memcpy(out, j->p, len);
+    out[len] = '\0';
+    j->p += len;
+}
+
+static void json_skip(json_t *j) {
+    char tmp[VAL_LEN];
+    json_ws(j);
+    if (*j->p == '{' || *j->p == '[') {
+        char close = *j->p == '{' ? '}' : ']';
+        j->p++;
+        if (json_eat(j, close)) return;
+        do {
+            if (close == '}') {
+                json_string(j, tmp, sizeof(tmp));
+                if (!json_eat(j, ':')) j->err = 1;
+            }
+            json_skip(j);
+        } while (!j->err && json_eat(j, ','));
+        if (!json_eat(j, close)) j->err = 1;
+    } else {
+        json_scalar(j, tmp, sizeof(tmp));
+    }
+}
+
+/* "params": { key: scalar, ... } */
+static void json_params(json_t *j) {
+    if (!json_eat(j, '{')) { j->err = 1; return; }
+    if (json_eat(j, '}')) return;
+    do {
+        char key[VAL_LEN], val[VAL_LEN];
+        json_string(j, key, sizeof(key));
+        if (!json_eat(j, ':')) { j->err = 1; return; }
+        json_scalar(j, val, sizeof(val));
+        if (!j->err) param_set(key, val);
+    } while (!j->err && json_eat(j, ','));
+    if (!json_eat(j, '}')) j->err = 1;
+}
+
+/* "automation": { key: [[t, v], ...], ... } */
+static void json_automation(json_t *j) {
+    if (!json_eat(j, '{')) { j->err = 1; return; }
+    if (json_eat(j, '}')) return;
+    do {
+        char key[VAL_LEN], t[VAL_LEN], val[VAL_LEN];
+        json_string(j, key, sizeof(key));
+        if (!json_eat(j, ':') || !json_eat(j, '[')) { j->err = 1; return; }
+        env_t *e = env_reset(key);
+        if (!e) { j->err = 1; return; }
+        if (json_eat(j, ']')) {
+            fprintf(stderr, "jc-render: automation for %s has no points\n", key);
+            j->err = 1;
+            return;
+        }
+        do {
+            if (!json_eat(j, '[')) { j->err = 1; return; }
+            json_scalar(j, t, sizeof(t));
+            if (!json_eat(j, ',')) { j->err = 1; return; }
+            json_scalar(j, val, sizeof(val));
+            if (!json_eat(j, ']')) { j->err = 1; return; }
+            if (env_add(e, atof(t), val) != 0) { j->err = 1; return; }
+        } while (json_eat(j, ','));
+        if (!json_eat(j, ']')) j->err = 1;
+    } while (!j->err && json_eat(j, ','));
+    if (!json_eat(j, '}')) j->err = 1;
+}
+
+static int load_sidecar(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *text = (char *)malloc((size_t)len + 1);
+    if (!text || fread(text, 1, (size_t)len, f) != (size_t)len) {
+        fprintf(stderr, "jc-render: %s: read failed\n", path);
+        free(text);
+        fclose(f);
+        return -1;
+    }
+    text[len] = '\0';
+    fclose(f);
+
+    json_t j = { text, 0 };
+    if (!json_eat(&j, '{')) j.err = 1;
+    if (!j.err && !json_eat(&j, '}')) {
+        do {
+            char key[VAL_LEN];
+            json_string(&j, key, sizeof(key));
+            if (!json_eat(&j, ':')) { j.err = 1; break; }
+            if (strcmp(key, "params") == 0)          json_params(&j);
+            else if (strcmp(key, "automation") == 0) json_automation(&j);
+            else                                     json_skip(&j);
+        } while (!j.err && json_eat(&j, ','));
+        if (!j.err && !json_eat(&j, '}')) j.err = 1;
+    }
+    if (j.err)
+        fprintf(stderr, "jc-render: %s: JSON error near offset %ld\n", path, (long)(j.p - text));
+    free(text);
+    return j.err ? -1 : 0;
+}
+
+/* --- Rendering --- */
+
+/* Send automated values for time t that differ from what was last sent */
+static void apply_automation(move_host_t *host, void *inst, double t) {
+    for (int i = 0; i < g_n_envs; i++) {
+        env_t *e = &g_envs[i];
+        char val[VAL_LEN];
+        env_value(e, t, val);
+        if (strcmp(val, e->sent) == 0) continue;
+        host->fx->set_param(inst, e->key, val);
+        memcpy(e->sent, val, VAL_LEN);
+    }
+}
+
+int main(int argc, char **argv) {
+    int frames = MOVE_FRAMES_PER_BLOCK;
+    int out_fmt = -1;
+    const char *in_path = NULL, *out_path = NULL, *sidecar = NULL;
+    const char *path = "auto";
+    const char *params[MAX_ARGS], *envs[MAX_ARGS];
+    int n_params = 0, n_envs = 0, tail = 0, verbose = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "b:t:p:a:j:P:i:o:Tvh")) != -1) {
+        switch (opt) {
+        case 'b': frames = atoi(optarg); break;
+        case 't':
+            if ((out_fmt = parse_fmt(optarg)) < 0) { usage(); return 2; }
+            break;
+        case 'p': if (n_params < MAX_ARGS) params[n_params++] = optarg; break;
+        case 'a': if (n_envs < MAX_ARGS) envs[n_envs++] = optarg; break;
+        case 'j': sidecar = optarg; break;
+        case 'P': path = optarg; break;
+        case 'i': in_path = optarg; break;
+        case 'o': out_path = optarg; break;
+        case 'T': tail = 1; break;
+        case 'v': verbose = 1; break;
+        default: usage(); return opt == 'h' ? 0 : 2;
+        }
+    }
+    if (optind != argc - 1 || frames <= 0 || !in_path || !out_path ||
+        (strcmp(path, "auto") && strcmp(path, "s16") && strcmp(path, "f32"))) {
+        usage();
+        return 2;
+    }
+
+    /* Sidecar first, so the command line overrides it */
+    if (sidecar && load_sidecar(sidecar) != 0) return 1;
+    for (int i = 0; i < n_params; i++) {
+        if (parse_param_arg(params[i]) != 0) {
+            fprintf(stderr, "jc-render: bad -p %s\n", params[i]);
+            return 2;
+        }
+    }
+    for (int i = 0; i < n_envs; i++) {
+        if (parse_env_arg(envs[i]) != 0) {
+            fprintf(stderr, "jc-render: bad -a %s\n", envs[i]);
+            return 2;
+        }
+    }
+
+    wav_in_t in;
+    if (wav_open(&in, in_path) != 0) {
+        wav_close(&in);
+        return 1;
+    }
+    if (out_fmt < 0) out_fmt = in.format;
+
+    move_host_t *host = (move_host_t *)malloc(sizeof(move_host_t));
+    if (!host) return 1;
+    move_host_init(host, in.rate, frames);
+    host->verbose = verbose;
+    if (move_host_load_fx(host, argv[optind]) != 0) {
+        move_host_free(host);
+        free(host);
+        wav_close(&in);
+        return 1;
+    }
+
+    int use_f32 = strcmp(path, "f32") == 0 ||
+                  (strcmp(path, "auto") == 0 && host->fx_v3 &&
+                   (in.format != FMT_S16 || out_fmt != FMT_S16));
+    if (use_f32 && !host->fx_v3) {
+        fprintf(stderr, "jc-render: module has no process_block_f32\n");
+        move_host_free(host);
+        free(host);
+        wav_close(&in);
+        return 1;
+    }
+
+    void *inst = host->fx->create_instance(".", NULL);
+    if (!inst) {
+        fprintf(stderr, "jc-render: create_instance failed\n");
+        move_host_free(host);
+        free(host);
+        wav_close(&in);
+        return 1;
+    }
+    for (int i = 0; i < g_n_params; i++)
+        host->fx->set_param(inst, g_params[i].key, g_params[i].val);
+
+    long tail_frames = 0;
+    if (tail) {
+        char val[32];
+        if (host->fx->get_param(inst, "tail_samples", val, sizeof(val)) > 0)
+            tail_frames = atol(val);
+    }
+
+    wav_out_t out = { 0 };
+    int16_t *buf = (int16_t *)calloc((size_t)frames * 2, sizeof(int16_t));
+    float *fbuf = (float *)calloc((size_t)frames * 2, sizeof(float));
+    int rc = 0;
+    if (!buf || !fbuf || wav_create(&out, out_path, out_fmt, in.rate, frames) != 0) {
+        fprintf(stderr, "jc-render: cannot write %s\n", out_path);
+        rc = 1;
+    }
+
+    long total = in.frames + tail_frames;
+    double busy = 0.0;
+    double t_start = now_sec();
+
+    for (long base = 0; rc == 0 && base < total; base += frames) {
+        int n = total - base < frames ? (int)(total - base) : frames;
+        apply_automation(host, inst, (double)base / in.rate);
+
+        /* Past the end of the input: silence for the tail */
+        for (int i = 0; i < n; i++) {
+            long f = base + i;
+            for (int c = 0; c < 2; c++) {
+                if (use_f32) fbuf[i * 2 + c] = f < in.frames ? wav_get_f32(&in, f, c) : 0.0f;
+                else         buf[i * 2 + c]  = f < in.frames ? wav_get_s16(&in, f, c) : 0;
+            }
+        }
+        wav_drop_before(&in, base + n < in.frames ? base + n : in.frames);
+
+        double t0 = now_sec();
+        if (use_f32) move_host_process_f32(host, inst, fbuf, n);
+        else         move_host_process(host, inst, buf, n);
+        busy += now_sec() - t0;
+
+        if (wav_write(&out, fbuf, use_f32 ? NULL : buf, n) != 0) {
+            fprintf(stderr, "jc-render: write to %s failed\n", out_path);
+            rc = 1;
+        }
+    }
+    double wall = now_sec() - t_start;
+    if (wav_finish(&out) != 0 && rc == 0) {
+        fprintf(stderr, "jc-render: finishing %s failed\n", out_path);
+        rc = 1;
+    }
+
+    if (rc == 0) {
+        double audio_sec = (double)total / in.rate;
+        printf("input:     %s, %d Hz, %s, %d ch, %ld frames\n", in_path, in.rate,
+               fmt_names[in.format], in.channels, in.frames);
+        printf("output:    %s, %s, 2 ch, %ld frames (%.3f s)\n", out_path,
+               fmt_names[out_fmt], total, audio_sec);
+        printf("path:      %s, %d-frame blocks, %d automated\n",
+               use_f32 ? "process_block_f32" : "process_block", frames, g_n_envs);
+        printf("dsp time:  %.3f ms (%.1fx realtime)\n", busy * 1e3,
+               busy > 0.0 ? audio_sec / busy : 0.0);
+        printf("wall time: %.3f ms (%.1fx realtime)\n", wall * 1e3,
+               wall > 0.0 ? audio_sec / wall : 0.0);
+    }
+
+    free(buf);
+    free(fbuf);
+    for (int i = 0; i < g_n_envs; i++) free(g_envs[i].pts);
+    host->fx->destroy_instance(inst);
+    move_host_free(host);
+    free(host);
+    wav_close(&in);
+    return rc;
+}